@@ -0,0 +1,184 @@
+//----------------------------------------------------------------------------
+// alloc_tracker.hpp
+//
+// Replaces the global operator new and delete to count allocations, bytes
+// allocated and live heap bytes. Include it in exactly one translation unit
+// of a program, after parser_combinators.hpp if that is used: built with
+// PROFILE_RULES, allocations are also charged to the innermost named rule
+// running on the allocating thread, and appear in the rule profile.
+
+#ifndef ALLOC_TRACKER_HPP
+#define ALLOC_TRACKER_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <new>
+#include <deque>
+#include <mutex>
+#include <algorithm>
+
+//----------------------------------------------------------------------------
+// Alloc Tracker: process wide counters. Each block carries a header holding
+// its size, so frees can be subtracted from the live total; the header is
+// sixteen bytes to keep the fundamental alignment.
+
+class alloc_tracker {
+    static std::atomic<uint64_t>& counter(int const k) {
+        static std::atomic<uint64_t> c[4];
+        return c[k];
+    }
+
+public:
+    static size_t const header = 16;
+
+    static std::atomic<uint64_t>& allocations() {
+        return counter(0);
+    }
+
+    static std::atomic<uint64_t>& bytes() {
+        return counter(1);
+    }
+
+    static std::atomic<uint64_t>& live() {
+        return counter(2);
+    }
+
+    static std::atomic<uint64_t>& peak() {
+        return counter(3);
+    }
+
+    static void* allocate(size_t const n) {
+        void* const p = malloc(n + header);
+        if (p == nullptr) {
+            return nullptr;
+        }
+        *static_cast<size_t*>(p) = n;
+        allocations().fetch_add(1, std::memory_order_relaxed);
+        bytes().fetch_add(n, std::memory_order_relaxed);
+        uint64_t const l = live().fetch_add(n, std::memory_order_relaxed) + n;
+        uint64_t k = peak().load(std::memory_order_relaxed);
+        while (l > k && !peak().compare_exchange_weak(k, l, std::memory_order_relaxed));
+#if defined(PROFILE_RULES) && defined(PARSER_COMBINATORS_HPP)
+        rule_stats* const s = rule_scope::current();
+        if (s != nullptr) {
+            ++s->allocations;
+            s->allocated_bytes += n;
+        }
+#endif
+        return static_cast<char*>(p) + header;
+    }
+
+    static void release(void* const p) {
+        if (p != nullptr) {
+            void* const b = static_cast<char*>(p) - header;
+            live().fetch_sub(*static_cast<size_t*>(b), std::memory_order_relaxed);
+            free(b);
+        }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Alloc Scope: like profile<T>, constructing an alloc_scope<T> starts a
+// measurement for tag T and destroying it adds the allocations, bytes and
+// peak live bytes above the starting level to T's totals. Allocations by all
+// threads during the scope are counted. Scopes may nest: the peak is reset
+// for the scope and the outer peak restored after it.
+
+struct alloc_report {
+    uint64_t samples;
+    uint64_t allocations;
+    uint64_t bytes;
+    uint64_t peak_bytes;
+};
+
+template <typename T> class alloc_scope {
+    struct totals {
+        std::mutex m;
+        alloc_report r;
+    };
+
+    static totals& all() {
+        static totals t;
+        return t;
+    }
+
+    uint64_t const allocations;
+    uint64_t const bytes;
+    uint64_t const live;
+    uint64_t const outer_peak;
+
+public:
+    alloc_scope(alloc_scope const&) = delete;
+
+    alloc_scope()
+        : allocations(alloc_tracker::allocations().load(std::memory_order_relaxed))
+        , bytes(alloc_tracker::bytes().load(std::memory_order_relaxed))
+        , live(alloc_tracker::live().load(std::memory_order_relaxed))
+        , outer_peak(alloc_tracker::peak().exchange(live, std::memory_order_relaxed)) {}
+
+    ~alloc_scope() {
+        uint64_t const peak = alloc_tracker::peak().load(std::memory_order_relaxed);
+        uint64_t k = peak;
+        while (outer_peak > k && !alloc_tracker::peak().compare_exchange_weak(k, outer_peak, std::memory_order_relaxed));
+        totals& t = all();
+        std::lock_guard<std::mutex> lock(t.m);
+        ++t.r.samples;
+        t.r.allocations += alloc_tracker::allocations().load(std::memory_order_relaxed) - allocations;
+        t.r.bytes += alloc_tracker::bytes().load(std::memory_order_relaxed) - bytes;
+        t.r.peak_bytes = std::max(t.r.peak_bytes, (peak > live) ? peak - live : 0);
+    }
+
+    static void reset() {
+        totals& t = all();
+        std::lock_guard<std::mutex> lock(t.m);
+        t.r = alloc_report {0, 0, 0, 0};
+    }
+
+    static alloc_report report() {
+        totals& t = all();
+        std::lock_guard<std::mutex> lock(t.m);
+        return t.r;
+    }
+};
+
+//----------------------------------------------------------------------------
+// The replaced allocation functions.
+
+void* operator new(size_t const n) {
+    void* const p = alloc_tracker::allocate(n);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t const n) {
+    return operator new(n);
+}
+
+void* operator new(size_t const n, std::nothrow_t const&) noexcept {
+    return alloc_tracker::allocate(n);
+}
+
+void* operator new[](size_t const n, std::nothrow_t const&) noexcept {
+    return alloc_tracker::allocate(n);
+}
+
+void operator delete(void* const p) noexcept {
+    alloc_tracker::release(p);
+}
+
+void operator delete[](void* const p) noexcept {
+    alloc_tracker::release(p);
+}
+
+void operator delete(void* const p, std::nothrow_t const&) noexcept {
+    alloc_tracker::release(p);
+}
+
+void operator delete[](void* const p, std::nothrow_t const&) noexcept {
+    alloc_tracker::release(p);
+}
+
+#endif // ALLOC_TRACKER_HPP
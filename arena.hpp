@@ -0,0 +1,274 @@
+//----------------------------------------------------------------------------
+// arena.hpp
+//
+// A bump allocator for parse results. Results opt in by type: a container
+// with an arena_allocator, such as arena_vector, allocates from the arena of
+// the innermost arena_scope open on its thread when it is constructed, and
+// from the heap if there is none. The container keeps that arena, so it may
+// grow after the scope closes. Nothing else is affected: statics, thread
+// local caches and memo tables created during a parse use the heap.
+//
+// arena_result<T> is T with every vector and string in it, however deeply
+// nested in vectors, pairs and tuples, using an arena_allocator, so a
+// grammar moves its attributes to the arena by wrapping its result types
+// rather than rewriting them; accept<arena_string> and basic_accept_str
+// produce recogniser strings in the same way. The types have to change:
+// a std::allocator cannot be pointed at an arena without replacing the
+// global operator new.
+//
+// Deallocating arena memory does nothing. The memory is only returned by
+// release() or reset(), or when the arena_owned holding a result is dropped,
+// so no result from the arena may be used after any of these, however long
+// it is kept. A result created with parse_arena::create is never destroyed:
+// only use it for types whose destructors just free memory.
+// Scopes are per thread, so par_many items and push_parser threads allocate
+// from the heap as usual.
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+class parse_arena {
+    struct chunk {
+        chunk* next;
+        size_t size;
+    };
+
+    static size_t const align = 16;
+    static size_t const header = (sizeof(chunk) + align - 1) & ~(align - 1);
+    static size_t const max_chunk = size_t(1) << 26;
+
+    chunk* head;
+    char* ptr;
+    char* end;
+    size_t next_size;
+    size_t used_bytes;
+    size_t reserved_bytes;
+
+    void grow(size_t const n) {
+        size_t const size = std::max(next_size, n + header);
+        chunk* const c = static_cast<chunk*>(malloc(size));
+        if (c == nullptr) {
+            throw std::bad_alloc();
+        }
+        c->next = head;
+        c->size = size;
+        head = c;
+        ptr = reinterpret_cast<char*>(c) + header;
+        end = reinterpret_cast<char*>(c) + size;
+        reserved_bytes += size;
+        next_size = (next_size < max_chunk / 2) ? next_size * 2 : max_chunk;
+    }
+
+public:
+    parse_arena(parse_arena const&) = delete;
+    parse_arena& operator= (parse_arena const&) = delete;
+
+    explicit parse_arena(size_t const initial = size_t(1) << 16)
+        : head(nullptr), ptr(nullptr), end(nullptr), next_size(std::max(initial, header + align))
+        , used_bytes(0), reserved_bytes(0) {}
+
+    ~parse_arena() {
+        release();
+    }
+
+    void* allocate(size_t n) {
+        n = (n + align - 1) & ~(align - 1);
+        if (static_cast<size_t>(end - ptr) < n) {
+            grow(n);
+        }
+        void* const p = ptr;
+        ptr += n;
+        used_bytes += n;
+        return p;
+    }
+
+    // Constructs a T in the arena; it is never destroyed.
+    template <typename T, typename... As> T* create(As&&... as) {
+        return new (allocate(sizeof(T))) T(std::forward<As>(as)...);
+    }
+
+    // Frees every chunk. Nothing allocated from the arena may be used after.
+    void release() {
+        while (head != nullptr) {
+            chunk* const c = head;
+            head = c->next;
+            free(c);
+        }
+        ptr = end = nullptr;
+        used_bytes = reserved_bytes = 0;
+    }
+
+    // Like release, but keeps the largest chunk for reuse, so a parse after
+    // the first needs no fresh memory if its results fit.
+    void reset() {
+        chunk* keep = head;
+        for (chunk* c = head; c != nullptr; c = c->next) {
+            if (c->size > keep->size) {
+                keep = c;
+            }
+        }
+        if (keep == nullptr) {
+            return;
+        }
+        chunk** at = &head;
+        while (*at != keep) {
+            at = &(*at)->next;
+        }
+        *at = keep->next;
+        release();
+        keep->next = nullptr;
+        head = keep;
+        ptr = reinterpret_cast<char*>(keep) + header;
+        end = reinterpret_cast<char*>(keep) + keep->size;
+        reserved_bytes = keep->size;
+    }
+
+    size_t used() const {
+        return used_bytes;
+    }
+
+    size_t reserved() const {
+        return reserved_bytes;
+    }
+
+    // The arena of the innermost scope open on this thread, if any.
+    static parse_arena*& current() {
+        static thread_local parse_arena* a = nullptr;
+        return a;
+    }
+};
+
+class arena_scope {
+    parse_arena* const outer;
+
+public:
+    arena_scope(arena_scope const&) = delete;
+
+    explicit arena_scope(parse_arena& a) : outer(parse_arena::current()) {
+        parse_arena::current() = &a;
+    }
+
+    ~arena_scope() {
+        parse_arena::current() = outer;
+    }
+};
+
+//----------------------------------------------------------------------------
+// Arena Allocator: allocates from the arena it was constructed with, which
+// is the current arena by default, or from the heap without one. Copies and
+// rebinds share the arena.
+
+template <typename T> class arena_allocator {
+    template <typename U> friend class arena_allocator;
+
+    parse_arena* arena;
+
+public:
+    using value_type = T;
+
+    arena_allocator() : arena(parse_arena::current()) {}
+    explicit arena_allocator(parse_arena& a) : arena(&a) {}
+    template <typename U> arena_allocator(arena_allocator<U> const& a) : arena(a.arena) {}
+
+    T* allocate(size_t const n) {
+        if (arena == nullptr) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(arena->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* const p, size_t) {
+        if (arena == nullptr) {
+            ::operator delete(p);
+        }
+    }
+
+    template <typename U> bool operator== (arena_allocator<U> const& a) const {
+        return arena == a.arena;
+    }
+
+    template <typename U> bool operator!= (arena_allocator<U> const& a) const {
+        return arena != a.arena;
+    }
+};
+
+template <typename T> using arena_vector = std::vector<T, arena_allocator<T>>;
+
+//----------------------------------------------------------------------------
+// Arena Results: rebinds the allocator of every vector and string in a
+// result type to an arena_allocator.
+
+template <typename T> struct arena_rebind {
+    using type = T;
+};
+
+template <typename T> using arena_result = typename arena_rebind<T>::type;
+
+template <typename T, typename A> struct arena_rebind<std::vector<T, A>> {
+    using type = arena_vector<arena_result<T>>;
+};
+
+template <typename C, typename Tr, typename A> struct arena_rebind<std::basic_string<C, Tr, A>> {
+    using type = std::basic_string<C, Tr, arena_allocator<C>>;
+};
+
+template <typename T, typename U> struct arena_rebind<std::pair<T, U>> {
+    using type = std::pair<arena_result<T>, arena_result<U>>;
+};
+
+template <typename... Ts> struct arena_rebind<std::tuple<Ts...>> {
+    using type = std::tuple<arena_result<Ts>...>;
+};
+
+using arena_string = arena_result<std::string>;
+
+//----------------------------------------------------------------------------
+// Arena Owned: a result constructed in an arena of its own, which is freed
+// when the result is dropped. Parse into it with an arena_scope on arena()
+// open, so everything the result allocates lands there too. Dropping it
+// frees the chunks without running the result's destructor, so, as with
+// create, the result may only hold arena memory.
+
+template <typename T> class arena_owned {
+    std::unique_ptr<parse_arena> a;
+    T* v;
+
+public:
+    arena_owned(arena_owned const&) = delete;
+    arena_owned& operator= (arena_owned const&) = delete;
+    arena_owned(arena_owned&&) = default;
+    arena_owned& operator= (arena_owned&&) = default;
+
+    explicit arena_owned(size_t const initial = size_t(1) << 16) : a(new parse_arena(initial)) {
+        arena_scope const scope(*a);
+        v = a->create<T>();
+    }
+
+    parse_arena& arena() const {
+        return *a;
+    }
+
+    T* get() const {
+        return v;
+    }
+
+    T& operator* () const {
+        return *v;
+    }
+
+    T* operator-> () const {
+        return v;
+    }
+};
+
+#endif // ARENA_HPP
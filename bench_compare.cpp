@@ -0,0 +1,199 @@
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <map>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+
+#include "parser_combinators.hpp"
+#include "memory_range.hpp"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+// Compares two benchmark result files, as written by the bench targets (one
+// JSON record per line), and flags every metric of every run present in both
+// that got worse by more than the threshold, or whose run failed or changed
+// checksum. Exits with status 1 if anything was flagged.
+
+struct json_value {
+    bool is_number;
+    double number;
+    string text;
+};
+
+using json_record = map<string, json_value>;
+
+struct return_number {
+    return_number() {}
+    void operator() (json_value *v, double n) const {
+        v->is_number = true;
+        v->number = n;
+    }
+} const return_number;
+
+struct return_text {
+    return_text() {}
+    void operator() (json_value *v, string &s) const {
+        v->is_number = false;
+        v->text = move(s);
+    }
+} const return_text;
+
+struct return_field {
+    return_field() {}
+    void operator() (json_record *r, string &k, json_value &v) const {
+        (*r)[k] = move(v);
+    }
+} const return_field;
+
+auto const quote = accept(is_char('"'));
+auto const string_tok = tokenise(discard(quote)
+    && many(accept(is_print - (is_char('"') || is_char('\\'))) || (discard(accept(is_char('\\'))) && accept(is_print)))
+    && discard(quote));
+auto const number_tok = tokenise(accept_float<double>());
+auto const bool_tok = tokenise(accept_str("true") || accept_str("false"));
+
+auto const value = all(return_text, string_tok) || all(return_text, bool_tok) || all(return_number, number_tok);
+auto const field = all(return_field, string_tok, discard(tokenise(accept(is_char(':')))) && value);
+
+auto const parse_record = strict("error parsing benchmark record", first_token
+    && discard(tokenise(accept(is_char('{'))))
+    && sep_by(field, discard(tokenise(accept(is_char(',')))))
+    && discard(tokenise(accept(is_char('}')))));
+
+//----------------------------------------------------------------------------
+
+string text(json_record const& r, char const* const k) {
+    auto const f = r.find(k);
+    if (f == r.end()) {
+        return "";
+    } else if (!f->second.is_number) {
+        return f->second.text;
+    }
+    ostringstream s;
+    s << setprecision(17) << f->second.number;
+    return s.str();
+}
+
+// Identifies a run: the corpus is compared by file name, so results from
+// different directories line up. Arena runs are separate runs.
+string run_key(json_record const& r) {
+    string corpus = text(r, "corpus");
+    size_t const slash = corpus.rfind('/');
+    if (slash != string::npos) {
+        corpus = corpus.substr(slash + 1);
+    }
+    string const backend = text(r, "backend") + ((text(r, "arena") == "true") ? "+arena" : "");
+    return text(r, "grammar") + " " + text(r, "parser") + " " + backend + " " + corpus;
+}
+
+map<string, json_record> load(char const* const name) {
+    ifstream in(name);
+    if (!in.is_open()) {
+        throw runtime_error(string("unable to open ") + name);
+    }
+    map<string, json_record> runs;
+    string line;
+    for (int n = 1; getline(in, line); ++n) {
+        if (line.find_first_not_of(" \t\r") == string::npos) {
+            continue;
+        }
+        memory_range const r(line);
+        memory_range::iterator i = r.first;
+        json_record record;
+        try {
+            parse_record(i, r, &record);
+        } catch (parse_error const& e) {
+            throw runtime_error(string(name) + ":" + to_string(n) + ": " + e.what());
+        }
+        runs[run_key(record)] = move(record);
+    }
+    return runs;
+}
+
+struct metric {
+    char const* name;
+    bool higher_is_better;
+};
+
+metric const metrics[] = {
+    {"mb_per_s", true},
+    {"cpu_ns_per_byte", false},
+    {"allocations", false},
+    {"allocated_bytes", false},
+    {"peak_heap_bytes", false},
+    {"peak_rss_kb", false},
+    {"cycles_per_mb", false},
+    {"instructions_per_mb", false},
+    {"branch_misses_per_mb", false},
+    {"cache_misses_per_mb", false}
+};
+
+int main(int const argc, char const *argv[]) {
+    double threshold = 5.0;
+    vector<char const*> files;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.size() != 2) {
+        cerr << "usage: " << argv[0] << " [--threshold percent] old.jsonl new.jsonl\n";
+        return 2;
+    }
+
+    map<string, json_record> old_runs, new_runs;
+    try {
+        old_runs = load(files[0]);
+        new_runs = load(files[1]);
+    } catch (runtime_error const& e) {
+        cerr << e.what() << "\n";
+        return 2;
+    }
+
+    int flagged = 0;
+    cout << fixed << setprecision(2);
+    for (auto const& n : new_runs) {
+        auto const o = old_runs.find(n.first);
+        if (o == old_runs.end()) {
+            cout << n.first << ": new run\n";
+            continue;
+        }
+        json_record const& a = o->second;
+        json_record const& b = n.second;
+        if (text(b, "ok") != "true") {
+            cout << n.first << ": FAILED\n";
+            ++flagged;
+        } else if (text(a, "checksum") != text(b, "checksum")) {
+            cout << n.first << ": CHECKSUM " << text(a, "checksum") << " -> " << text(b, "checksum") << "\n";
+            ++flagged;
+        }
+        for (metric const& m : metrics) {
+            auto const x = a.find(m.name);
+            auto const y = b.find(m.name);
+            if (x == a.end() || y == b.end() || !x->second.is_number || !y->second.is_number) {
+                continue;
+            }
+            double const before = x->second.number;
+            double const after = y->second.number;
+            double const change = (before == 0.0) ? ((after == 0.0) ? 0.0 : 100.0) : 100.0 * (after - before) / before;
+            bool const worse = m.higher_is_better ? (change < -threshold) : (change > threshold);
+            cout << n.first << ": " << m.name << " " << before << " -> " << after
+                << " (" << showpos << change << noshowpos << "%)" << (worse ? " REGRESSION" : "") << "\n";
+            flagged += worse ? 1 : 0;
+        }
+    }
+    for (auto const& o : old_runs) {
+        if (new_runs.find(o.first) == new_runs.end()) {
+            cout << o.first << ": missing\n";
+        }
+    }
+    cout << flagged << " regressions\n";
+    return (flagged > 0) ? 1 : 0;
+}
@@ -0,0 +1,313 @@
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+
+#include "profile.hpp"
+#include "corpus.hpp"
+
+#ifdef USE_SIMPLE
+#include "parser_simple.hpp"
+#else
+#include "parser_combinators.hpp"
+#include "stream_iterator.hpp"
+#include "memory_range.hpp"
+#endif
+
+#include "arena.hpp"
+#include "alloc_tracker.hpp"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+// CSV benchmark driver: parses each file 'warmup' times untimed, then 'reps'
+// times timed, and prints one JSON record per file. Built against
+// parser_simple.hpp (USE_SIMPLE) or parser_combinators.hpp with the backend
+// chosen on the command line, so every parser and backend runs the same
+// grammar. Rows are folded into a running sum rather than kept, so memory
+// does not grow with the corpus; the checksum is the mean row sum, as printed
+// by mkcsv. If mkcsv wrote a FILE.sum, a run is only ok if it matches: the
+// same checksum, or a parse error if errors were injected. Rows are
+// arena_vectors, so with --arena they are allocated from a parse_arena that
+// is reset after each parse, and from the heap without it.
+//
+// Every backend opens its input before the timed region: the stream backend
+// opens the file, mmap maps it, and memory reads it all. The timed region is
+// the same for all of them, making the range over the open input and parsing
+// it, so the stream and mmap backends read the file while timed (through the
+// stream buffer or page faults) and memory does not.
+
+//----------------------------------------------------------------------------
+
+struct csv_totals {
+    int64_t sum;
+    int64_t rows;
+
+    int64_t checksum() const {
+        return (rows == 0) ? 0 : sum / rows;
+    }
+};
+
+struct csv_bench;
+
+#ifdef USE_SIMPLE
+
+char const* const parser_kind = "simple";
+char const* const backends[] = {"stream"};
+
+struct csv_parser : private parser {
+    csv_parser(istream &in) : parser(in) {}
+
+    bool separator() {
+        accept(is_char(','), nullptr) && space();
+        return true;
+    }
+
+    bool parse_int(arena_vector<int> &ts) {
+        string n;
+        if (number(&n) && separator()) {
+            ts.push_back(stoi(n));
+            return true;
+        }
+        return false;
+    }
+
+    bool parse_line(arena_vector<int> &line, csv_totals &a) {
+        line.clear();
+        if (parse_int(line)) {
+            while (parse_int(line));
+            space();
+            for (int const v : line) {
+                a.sum += v;
+            }
+            ++a.rows;
+            return true;
+        }
+        return false;
+    }
+
+    size_t operator() (csv_totals &a) {
+        arena_vector<int> line;
+        if (parse_line(line, a)) {
+            while (parse_line(line, a));
+        }
+        return get_count();
+    }
+};
+
+size_t parse(char const* const, char const* const name, csv_totals &a) {
+    ifstream in(name, ios_base::in | ios_base::binary);
+    if (!in.is_open()) {
+        throw runtime_error("unable to open file");
+    }
+    profile<csv_bench> p;
+    alloc_scope<csv_bench> m;
+    return csv_parser(in)(a);
+}
+
+#else
+
+char const* const parser_kind = "combinators";
+char const* const backends[] = {"stream", "mmap", "memory"};
+
+struct parse_int {
+    parse_int() {}
+    void operator() (arena_vector<int> *ts, int num) const {
+        ts->push_back(num);
+    }
+} const parse_int;
+
+struct parse_line {
+    parse_line() {}
+    void operator() (csv_totals *a, arena_vector<int> &line) const {
+        for (int const v : line) {
+            a->sum += v;
+        }
+        ++a->rows;
+    }
+} const parse_line;
+
+auto const number_tok = tokenise(accept_int<int>());
+auto const separator_tok = tokenise(accept(is_char(',')));
+
+auto const parse_csv = strict("error parsing csv",
+    first_token && some(all(parse_line, sep_by(all(parse_int, number_tok), separator_tok)))
+);
+
+template <typename Range> size_t parse_range(Range const &r, csv_totals &a) {
+    typename Range::iterator i = r.first;
+    parse_csv(i, r, &a);
+    return static_cast<size_t>(i - r.first);
+}
+
+size_t parse(char const* const backend, char const* const name, csv_totals &a) {
+    if (strcmp(backend, "stream") == 0) {
+        ifstream file(name, ios_base::in | ios_base::binary);
+        if (!file.is_open()) {
+            throw runtime_error("unable to open file");
+        }
+        profile<csv_bench> p;
+        alloc_scope<csv_bench> m;
+        stream_range const r(file);
+        return parse_range(r, a);
+    } else if (strcmp(backend, "mmap") == 0) {
+        mapped_file const file(name);
+        profile<csv_bench> p;
+        alloc_scope<csv_bench> m;
+        return parse_range(memory_range(file.data(), file.size()), a);
+    } else {
+        ifstream file(name, ios_base::in | ios_base::binary);
+        if (!file.is_open()) {
+            throw runtime_error("unable to open file");
+        }
+        string const text {istreambuf_iterator<char>(file), istreambuf_iterator<char>()};
+        profile<csv_bench> p;
+        alloc_scope<csv_bench> m;
+        return parse_range(memory_range(text), a);
+    }
+}
+
+#endif // USE_SIMPLE
+
+//----------------------------------------------------------------------------
+
+// A parse error stops the parse like a failure does. Given an arena, the
+// parse allocates from it, and it is reset after the parse.
+size_t run(char const* const backend, char const* const name, csv_totals &a, bool &failed, parse_arena* const arena) {
+    a = csv_totals {0, 0};
+    failed = false;
+    try {
+        if (arena == nullptr) {
+            return parse(backend, name, a);
+        }
+        size_t consumed;
+        {
+            arena_scope s(*arena);
+            consumed = parse(backend, name, a);
+        }
+        arena->reset();
+        return consumed;
+    } catch (parse_error const&) {
+        if (arena != nullptr) {
+            arena->reset();
+        }
+        failed = true;
+        return 0;
+    }
+}
+
+string json_string(string const& s) {
+    string out = "\"";
+    for (char const c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out + "\"";
+}
+
+int main(int argc, char const *argv[]) {
+    bool const use_arena = argc > 1 && strcmp(argv[1], "--arena") == 0;
+    if (use_arena) {
+        ++argv;
+        --argc;
+    }
+    if (argc < 5 || find_if(begin(backends), end(backends), [argv] (char const* b) {
+        return strcmp(b, argv[1]) == 0;
+    }) == end(backends)) {
+        cerr << "usage: " << argv[0] << " [--arena] backend warmup reps files...\n" << "backends:";
+        for (char const* const b : backends) {
+            cerr << " " << b;
+        }
+        cerr << "\n";
+        return 1;
+    }
+
+    char const* const backend = argv[1];
+    int const warmup = max(0, atoi(argv[2]));
+    int const reps = max(1, atoi(argv[3]));
+    parse_arena arena;
+    parse_arena* const scratch = use_arena ? &arena : nullptr;
+    for (int f = 4; f < argc; ++f) {
+        char const* const name = argv[f];
+        ifstream file(name, ios_base::in | ios_base::binary | ios_base::ate);
+        if (!file.is_open()) {
+            cerr << "unable to open " << name << "\n";
+            return 1;
+        }
+        size_t const bytes = static_cast<size_t>(file.tellg());
+
+        csv_totals totals {0, 0};
+        size_t consumed = 0;
+        bool failed = false;
+        for (int k = 0; k < warmup; ++k) {
+            consumed = run(backend, name, totals, failed, scratch);
+        }
+
+        vector<double> mb_per_s;
+        uint64_t cpu_ns = 0;
+        uint64_t elapsed_ns = 0;
+        profile_report report;
+        alloc_scope<csv_bench>::reset();
+        for (int k = 0; k < reps; ++k) {
+            profile<csv_bench>::reset();
+            consumed = run(backend, name, totals, failed, scratch);
+            report = profile<csv_bench>::report();
+            mb_per_s.push_back(report.mb_per_s(bytes));
+            cpu_ns += report.cpu_ns;
+            elapsed_ns += report.elapsed_ns;
+        }
+        sort(mb_per_s.begin(), mb_per_s.end());
+        double const median = mb_per_s[mb_per_s.size() / 2];
+        double const per_byte = (bytes == 0) ? 0.0 : 1.0 / static_cast<double>(bytes * reps);
+        double const mb = static_cast<double>(bytes) / 1000000.0;
+        alloc_report const allocs = alloc_scope<csv_bench>::report();
+
+        vector<pair<string, string>> const expected = read_corpus_sum(name);
+        bool errors = false;
+        bool checksum = true;
+        for (auto const& e : expected) {
+            if (e.first == "errors") {
+                errors = e.second != "0";
+            } else if (e.first == "checksum") {
+                checksum = e.second == to_string(totals.checksum());
+            }
+        }
+        bool const complete = !failed && consumed == bytes;
+        bool const ok = errors ? !complete : complete && checksum;
+        cout << "{\"grammar\":\"csv\",\"parser\":\"" << parser_kind
+            << "\",\"backend\":\"" << backend
+            << "\",\"arena\":" << (use_arena ? "true" : "false")
+            << ",\"corpus\":" << json_string(name)
+            << ",\"bytes\":" << bytes
+            << ",\"warmup\":" << warmup
+            << ",\"reps\":" << reps
+            << ",\"ok\":" << (ok ? "true" : "false")
+            << ",\"checked\":" << (expected.empty() ? "false" : "true")
+            << ",\"checksum\":" << totals.checksum()
+            << ",\"mb_per_s\":" << median
+            << ",\"mb_per_s_min\":" << mb_per_s.front()
+            << ",\"mb_per_s_max\":" << mb_per_s.back()
+            << ",\"ns_per_byte\":" << static_cast<double>(elapsed_ns) * per_byte
+            << ",\"cpu_ns_per_byte\":" << static_cast<double>(cpu_ns) * per_byte
+            << ",\"allocations\":" << allocs.allocations / reps
+            << ",\"allocated_bytes\":" << allocs.bytes / reps
+            << ",\"allocations_per_mb\":" << static_cast<double>(allocs.allocations) / (mb * reps)
+            << ",\"allocated_bytes_per_mb\":" << static_cast<double>(allocs.bytes) / (mb * reps)
+            << ",\"peak_heap_bytes\":" << allocs.peak_bytes
+            << ",\"peak_rss_kb\":" << report.peak_rss_kb;
+        for (int e = 0; e < perf_counters::events; ++e) {
+            if (report.counted[e] && mb > 0.0) {
+                string key = perf_counters::name(e);
+                replace(key.begin(), key.end(), '-', '_');
+                cout << ",\"" << key << "_per_mb\":" << static_cast<double>(report.counters[e]) / mb;
+            }
+        }
+        cout << "}" << endl;
+    }
+}
@@ -0,0 +1,244 @@
+#ifndef CORPUS_HPP
+#define CORPUS_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+// Corpus Random: splitmix64, so a seed gives the same corpus on every
+// platform and standard library.
+
+class corpus_random {
+    uint64_t s;
+
+public:
+    explicit corpus_random(uint64_t const seed) : s(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (s += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    // uniform in [0, n), the modulo bias is negligible for small 'n'.
+    int below(int const n) {
+        return static_cast<int>(next() % static_cast<uint64_t>(n));
+    }
+
+    bool chance(double const p) {
+        return p > 0.0 && static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0) < p;
+    }
+};
+
+//----------------------------------------------------------------------------
+// Corpus Options: the options shared by the generators. Each generator lists
+// the ones it understands; the defaults give the shape of its old output.
+//
+//  --size MB       generate at least this much (0: the generator's default)
+//  --seed N        random seed
+//  --width N       values per row, or maximum arity
+//  --depth N       maximum nesting depth
+//  --space P       probability of extra whitespace between tokens
+//  --comments P    probability of a comment line before a clause
+//  --errors P      probability of an invalid token, at each token
+//  -o FILE         write FILE and the expected results to FILE.sum
+
+struct corpus_options {
+    double size_mb;
+    uint64_t seed;
+    int width;
+    int depth;
+    double space;
+    double comments;
+    double errors;
+    char const* out;
+
+    corpus_options(int const w, int const d)
+        : size_mb(0.0), seed(1), width(w), depth(d), space(0.0), comments(0.0), errors(0.0), out(nullptr) {}
+
+    uint64_t size_bytes() const {
+        return static_cast<uint64_t>(size_mb * 1000000.0);
+    }
+
+    // 'accepted' is a space separated list of option names.
+    bool parse(int const argc, char const* argv[], char const* const accepted) {
+        string const names = string(" ") + accepted + " ";
+        for (int i = 1; i < argc; ++i) {
+            string const arg = argv[i];
+            if (arg == "-o" && i + 1 < argc) {
+                out = argv[++i];
+                continue;
+            }
+            if (arg.compare(0, 2, "--") != 0 || i + 1 >= argc
+                || names.find(" " + arg.substr(2) + " ") == string::npos) {
+                return usage(argv[0], accepted);
+            }
+            char const* const v = argv[++i];
+            if (arg == "--size") {
+                size_mb = atof(v);
+            } else if (arg == "--seed") {
+                seed = strtoull(v, nullptr, 10);
+            } else if (arg == "--width") {
+                width = max(1, atoi(v));
+            } else if (arg == "--depth") {
+                depth = max(0, atoi(v));
+            } else if (arg == "--space") {
+                space = atof(v);
+            } else if (arg == "--comments") {
+                comments = atof(v);
+            } else if (arg == "--errors") {
+                errors = atof(v);
+            }
+        }
+        return true;
+    }
+
+private:
+    static bool usage(char const* const name, char const* const accepted) {
+        cerr << "usage: " << name;
+        string const names = accepted;
+        size_t b = 0;
+        while (b < names.size()) {
+            size_t e = names.find(' ', b);
+            if (e == string::npos) {
+                e = names.size();
+            }
+            cerr << " [--" << names.substr(b, e - b) << " n]";
+            b = e + 1;
+        }
+        cerr << " [-o file]\n";
+        return false;
+    }
+};
+
+//----------------------------------------------------------------------------
+// Corpus Output: buffered output that counts bytes and injected errors. If
+// writing to a named file, finish() writes the expected results beside it,
+// as "key value" lines in FILE.sum, for the benchmarks to check against.
+
+class corpus_output {
+    static size_t const buffer_size = 1 << 20;
+
+    FILE* f;
+    string name;
+    string buf;
+    uint64_t flushed;
+    uint64_t errors;
+    uint64_t first_error;
+
+    void flush() {
+        if (fwrite(buf.data(), 1, buf.size(), f) != buf.size()) {
+            throw runtime_error("unable to write file");
+        }
+        flushed += buf.size();
+        buf.clear();
+    }
+
+public:
+    corpus_output(corpus_output const&) = delete;
+
+    explicit corpus_output(char const* const file)
+        : f(stdout), name((file == nullptr) ? "" : file), flushed(0), errors(0), first_error(0) {
+        if (file != nullptr) {
+            f = fopen(file, "wb");
+            if (f == nullptr) {
+                throw runtime_error("unable to open file");
+            }
+        }
+        buf.reserve(buffer_size);
+    }
+
+    ~corpus_output() {
+        if (f != stdout) {
+            fclose(f);
+        }
+    }
+
+    uint64_t size() const {
+        return flushed + buf.size();
+    }
+
+    void put(char const c) {
+        buf.push_back(c);
+        if (buf.size() >= buffer_size) {
+            flush();
+        }
+    }
+
+    void put(char const* s) {
+        while (*s != '\0') {
+            put(*s++);
+        }
+    }
+
+    void put_int(int64_t const v) {
+        char tmp[24];
+        snprintf(tmp, sizeof(tmp), "%lld", static_cast<long long>(v));
+        put(tmp);
+    }
+
+    // With probability 'p', one to three whitespace characters.
+    void space(corpus_random& rnd, double const p, bool const newlines = true) {
+        if (rnd.chance(p)) {
+            static char const ws[] = {' ', '\t', '\n'};
+            for (int n = rnd.below(3); n >= 0; --n) {
+                put(ws[rnd.below(newlines ? 3 : 2)]);
+            }
+        }
+    }
+
+    // Called just before writing an invalid token.
+    void error() {
+        if (errors++ == 0) {
+            first_error = size();
+        }
+    }
+
+    void finish(vector<pair<string, string>> const& results) {
+        flush();
+        fflush(f);
+        if (name.empty()) {
+            return;
+        }
+        FILE* const sum = fopen((name + ".sum").c_str(), "w");
+        if (sum == nullptr) {
+            throw runtime_error("unable to open file");
+        }
+        fprintf(sum, "bytes %llu\nerrors %llu\n", static_cast<unsigned long long>(size()),
+            static_cast<unsigned long long>(errors));
+        if (errors > 0) {
+            fprintf(sum, "first_error %llu\n", static_cast<unsigned long long>(first_error));
+        }
+        for (auto const& r : results) {
+            fprintf(sum, "%s %s\n", r.first.c_str(), r.second.c_str());
+        }
+        fclose(sum);
+    }
+};
+
+// Reads "key value" lines from FILE.sum, empty if there is none.
+inline vector<pair<string, string>> read_corpus_sum(string const& file) {
+    vector<pair<string, string>> results;
+    FILE* const sum = fopen((file + ".sum").c_str(), "r");
+    if (sum != nullptr) {
+        char key[64], value[64];
+        while (fscanf(sum, "%63s %63s", key, value) == 2) {
+            results.emplace_back(key, value);
+        }
+        fclose(sum);
+    }
+    return results;
+}
+
+#endif // CORPUS_HPP
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <vector>
 #include <sstream>
+#include <cstdlib>
 
 #include "templateio.hpp"
 #include "parser_combinators.hpp"
@@ -15,8 +16,8 @@ using namespace std;
 
 struct return_int {
     return_int() {}
-    void operator() (int *res, string &num) const {
-        *res = stoi(num);
+    void operator() (int *res, int num) const {
+        *res = num;
     }
 } const return_int;
 
@@ -48,7 +49,7 @@ struct return_div {
     }
 } const return_div;
 
-auto const number_tok = tokenise(some(accept(is_digit)));
+auto const number_tok = tokenise(accept_int<int>());
 auto const start_tok = tokenise(accept(is_char('(')));
 auto const end_tok = tokenise(accept(is_char(')')));
 auto const add_tok = tokenise(accept(is_char('+')));
@@ -71,12 +72,12 @@ expression_handle const multiplicative_expr(expression_handle e) {
 }
 
 expression_handle recursive_expression(expression_handle expr) {
-    return attempt(number) || discard(start_tok) && (
+    return attempt(number) || (discard(start_tok) && (
             attempt(additive_expr(expr)) || multiplicative_expr(expr))
-            && discard(end_tok);
+            && discard(end_tok));
 }
 
-auto const expression = fix("expr", recursive_expression);
+auto const expression = memo_fix("expr", recursive_expression);
 auto const parser = first_token && strict("invalid expression", expression);
 
 struct expression_parser;
@@ -85,6 +86,7 @@ template <typename Range>
 int parse(Range const &r) {
     decltype(parser)::result_type a {}; 
     typename Range::iterator i = r.first;
+    expression.reset();
 
     profile<expression_parser> p;
     if (parser(i, r, &a)) {
@@ -94,6 +96,7 @@ int parse(Range const &r) {
     }
 
     cout << a << "\n";
+    cout << "memo " << expression.stats() << "\n";
     
     return i - r.first;
 }
@@ -104,13 +107,24 @@ int main(int const argc, char const *argv[]) {
     if (argc < 1) {
         cerr << "no input files\n";
     } else {
+        // set PARSER_TRACE to a file name to record a trace of the last input.
+        char const* const trace = getenv("PARSER_TRACE");
         for (int i = 1; i < argc; ++i) {
             profile<expression_parser>::reset();
+            if (trace != nullptr) {
+                parser_trace::start();
+            }
             stream_range in(argv[i]);
             cout << argv[i] << "\n";
             int const chars_read = parse(in);
-            double const mb_per_s = static_cast<double>(chars_read) / static_cast<double>(profile<expression_parser>::report());
-            cout << "parsed: " << mb_per_s << "MB/s\n";
+            profile_report const report = profile<expression_parser>::report();
+            cout << "parsed: " << report.mb_per_s(chars_read) << "MB/s\n" << report << "\n";
+            cout << report.per_mb(chars_read) << "\n";
+            if (trace != nullptr) {
+                parser_trace::stop();
+                ofstream out(trace, ios_base::out | ios_base::binary);
+                parser_trace::write(out);
+            }
         }
     }
 }
@@ -0,0 +1,120 @@
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <sstream>
+
+#include "templateio.hpp"
+#include "parser_combinators.hpp"
+#include "profile.hpp"
+#include "stream_iterator.hpp"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+// Example Operator Precedence Expression Parser.
+
+struct return_int {
+    return_int() {}
+    void operator() (int *res, int num) const {
+        *res = num;
+    }
+} const return_int;
+
+struct return_add {
+    return_add() {}
+    void operator() (int *res, int left, string&, int right) const {
+        *res = left + right;
+    }
+} const return_add;
+
+struct return_sub {
+    return_sub() {}
+    void operator() (int *res, int left, string&, int right) const {
+        *res = left - right;
+    }
+} const return_sub;
+
+struct return_mul {
+    return_mul() {}
+    void operator() (int *res, int left, string&, int right) const {
+        *res = left * right;
+    }
+} const return_mul;
+
+struct return_div {
+    return_div() {}
+    void operator() (int *res, int left, string&, int right) const {
+        if (right == 0) {
+            throw runtime_error("division by zero");
+        }
+        *res = left / right;
+    }
+} const return_div;
+
+struct return_neg {
+    return_neg() {}
+    void operator() (int *res, string&, int right) const {
+        *res = -right;
+    }
+} const return_neg;
+
+auto const number_tok = tokenise(accept_int<int>());
+auto const start_tok = tokenise(accept(is_char('(')));
+auto const end_tok = tokenise(accept(is_char(')')));
+auto const add_tok = tokenise(accept(is_char('+')));
+auto const sub_tok = tokenise(accept(is_char('-')));
+auto const mul_tok = tokenise(accept(is_char('*')));
+auto const div_tok = tokenise(accept(is_char('/')));
+
+using expression_handle = pstream_handle<int>;
+
+auto const number = define("number", all(return_int, number_tok));
+
+expression_handle recursive_expression(expression_handle e) {
+    return operators(number || (discard(start_tok) && e && discard(end_tok)),
+        infix_left(10, add_tok, return_add),
+        infix_left(10, sub_tok, return_sub),
+        infix_left(20, mul_tok, return_mul),
+        infix_left(20, div_tok, return_div),
+        prefix(30, sub_tok, return_neg));
+}
+
+auto const expression = fix("expr", recursive_expression);
+auto const parser = first_token && strict("invalid expression", expression);
+
+struct expression_parser;
+
+template <typename Range>
+int parse(Range const &r) {
+    decltype(parser)::result_type a {}; 
+    typename Range::iterator i = r.first;
+
+    profile<expression_parser> p;
+    if (parser(i, r, &a)) {
+        cout << "OK\n";
+    } else {
+        cout << "FAIL\n";
+    }
+
+    cout << a << "\n";
+    
+    return i - r.first;
+}
+
+//----------------------------------------------------------------------------
+
+int main(int const argc, char const *argv[]) {
+    if (argc < 1) {
+        cerr << "no input files\n";
+    } else {
+        for (int i = 1; i < argc; ++i) {
+            profile<expression_parser>::reset();
+            stream_range in(argv[i]);
+            cout << argv[i] << "\n";
+            int const chars_read = parse(in);
+            profile_report const report = profile<expression_parser>::report();
+            cout << "parsed: " << report.mb_per_s(chars_read) << "MB/s\n" << report << "\n";
+            cout << report.per_mb(chars_read) << "\n";
+        }
+    }
+}
@@ -0,0 +1,166 @@
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <iterator>
+#include <exception>
+
+#include "templateio.hpp"
+#include "parser_combinators.hpp"
+#include "memory_range.hpp"
+#include "parallel.hpp"
+#include "profile.hpp"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+// Example CSV file parser, parsing chunks of the file on several threads.
+
+struct parse_int {
+    parse_int() {}
+    void operator() (vector<int> *ts, int num) const {
+        ts->push_back(num);
+    }
+} const parse_int;
+
+struct parse_line {
+    parse_line() {}
+    void operator() (vector<vector<int>> *ts, vector<int> &line) const {
+        ts->push_back(move(line));
+    }
+} const parse_line;
+
+auto const number_tok = tokenise(accept_int<int>());
+auto const separator_tok = tokenise(accept(is_char(',')));
+
+auto const csv_line = all(parse_line, sep_by(all(parse_int, number_tok), separator_tok));
+
+auto const parse_csv = strict("error parsing csv", first_token && some(csv_line));
+
+// Newlines are whitespace between tokens, so a record continues over one
+// that has a separator as the last symbol before it or the first after it.
+struct csv_break {
+    csv_break() {}
+    bool operator() (char const* const f, char const* const nl, char const* const l) const {
+        char const* before = nl;
+        while (before != f && is_space(before[-1])) {
+            --before;
+        }
+        char const* after = nl + 1;
+        while (after != l && is_space(*after)) {
+            ++after;
+        }
+        return (before == f || before[-1] != ',') && (after == l || *after != ',');
+    }
+} const csv_break;
+
+struct csv_parser;
+struct csv_chunk;
+struct csv_par_many;
+
+// chunks per thread, so threads that finish early have work to steal.
+size_t const chunks_per_thread = 8;
+
+struct chunk_result {
+    decltype(parse_csv)::result_type rows;
+    size_t consumed;
+    exception_ptr error;
+};
+
+size_t parse(mapped_file const& file, size_t const threads, decltype(parse_csv)::result_type &a) {
+    vector<chunk_range> const chunks = split_records(file.data(), file.data() + file.size(),
+        threads * chunks_per_thread, csv_break);
+    vector<chunk_result> results(chunks.size());
+
+    parallel_for(chunks.size(), threads, [&chunks, &results] (size_t const k) {
+        profile<csv_chunk> p;
+        chunk_range const& r = chunks[k];
+        chunk_range::iterator i = r.first;
+        try {
+            parse_csv(i, r, &results[k].rows);
+        } catch (...) {
+            results[k].error = current_exception();
+        }
+        results[k].consumed = i - r.first;
+    });
+
+    // Merge in file order, stopping where a sequential parse would.
+    size_t rows = 0;
+    for (chunk_result const& c : results) {
+        rows += c.rows.size();
+    }
+    a.reserve(rows);
+    size_t consumed = 0;
+    for (size_t k = 0; k < chunks.size(); ++k) {
+        if (results[k].error) {
+            rethrow_exception(results[k].error);
+        }
+        a.insert(a.end(), make_move_iterator(results[k].rows.begin()), make_move_iterator(results[k].rows.end()));
+        consumed += results[k].consumed;
+        if (chunks[k].first + results[k].consumed != chunks[k].last) {
+            break;
+        }
+    }
+    return consumed;
+}
+
+// The same grammar with par_many, resynchronising after each newline.
+size_t parse_par_many(mapped_file const& file, size_t const threads, decltype(parse_csv)::result_type &a) {
+    auto const parser = strict("error parsing csv", first_token && csv_line && par_many(csv_line, is_eol, threads));
+    memory_range const r(file.data(), file.size());
+    memory_range::iterator i = r.first;
+    parser(i, r, &a);
+    return i - r.first;
+}
+
+int check(decltype(parse_csv)::result_type const& a) {
+    int sum = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (size_t j = 0; j < a[i].size(); j++) {
+           sum += a[i][j];
+        }
+    }
+    if (a.size() > 0) {
+        sum /= a.size();
+    }
+    return sum;
+}
+
+//----------------------------------------------------------------------------
+
+int main(int const argc, char const *argv[]) {
+    if (argc < 3) {
+        cerr << "usage: " << argv[0] << " threads files...\n";
+    } else {
+        size_t const threads = max(1, atoi(argv[1]));
+        for (int i = 2; i < argc; ++i) {
+            mapped_file const file(argv[i]);
+            cout << argv[i] << "\n";
+
+            profile<csv_parser>::reset();
+            profile<csv_chunk>::reset();
+            profile<csv_par_many>::reset();
+
+            decltype(parse_csv)::result_type a;
+            size_t chars_read;
+            {
+                profile<csv_parser> p;
+                chars_read = parse(file, threads, a);
+            }
+            cout << ((chars_read == file.size()) ? "OK\n" : "FAIL\n");
+            cerr << check(a) << endl;
+            profile_report const report = profile<csv_parser>::report();
+            cout << "threads: " << threads << " parsed: " << report.mb_per_s(chars_read) << "MB/s\n" << report << "\n";
+            cout << "chunks: " << profile<csv_chunk>::report() << "\n";
+
+            decltype(parse_csv)::result_type b;
+            size_t par_read;
+            {
+                profile<csv_par_many> p;
+                par_read = parse_par_many(file, threads, b);
+            }
+            cout << ((par_read == file.size() && a == b) ? "OK\n" : "FAIL\n");
+            profile_report const par_report = profile<csv_par_many>::report();
+            cout << "par_many threads: " << threads << " parsed: " << par_report.mb_per_s(par_read) << "MB/s\n" << par_report << "\n";
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <sstream>
+
+#include "templateio.hpp"
+#include "parser_combinators.hpp"
+#include "profile.hpp"
+#include "stream_iterator.hpp"
+#include "push_parser.hpp"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+// Example CSV parser fed in network sized chunks.
+
+struct parse_int {
+    parse_int() {}
+    void operator() (vector<int> *ts, int num) const {
+        ts->push_back(num);
+    }
+} const parse_int;
+
+struct parse_line {
+    parse_line() {}
+    void operator() (vector<vector<int>> *ts, vector<int> &line) const {
+        ts->push_back(move(line));
+    }
+} const parse_line;
+
+auto const number_tok = tokenise(accept_int<int>());
+auto const separator_tok = tokenise(accept(is_char(',')));
+
+auto const parse_csv = strict("error parsing csv",
+    first_token && some(all(parse_line, sep_by(all(parse_int, number_tok), separator_tok)))
+);
+
+struct csv_parser;
+
+size_t const chunk_size = 1460;
+
+int parse(istream &in) {
+    push_parser<decltype(parse_csv)> pp(parse_csv);
+    size_t max_retained = 0;
+
+    profile<csv_parser> p;
+    vector<char> chunk(chunk_size);
+    while (in.read(chunk.data(), chunk.size()) || in.gcount() > 0) {
+        if (!pp.feed(chunk.data(), in.gcount())) {
+            break;
+        }
+        max_retained = max(max_retained, pp.retained());
+    }
+    if (pp.finish()) {
+        cout << "OK\n";
+    } else {
+        cout << "FAIL\n";
+    }
+
+    vector<vector<int>> const& a = pp.result();
+    int sum = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (size_t j = 0; j < a[i].size(); j++) {
+           sum += a[i][j];
+        }
+    }
+    sum /= a.size();
+    cerr << sum << endl;
+    cout << "retained at most " << max_retained << " bytes\n";
+
+    return pp.consumed();
+}
+
+//----------------------------------------------------------------------------
+
+int main(int const argc, char const *argv[]) {
+    if (argc < 1) {
+        cerr << "no input files\n";
+    } else {
+        for (int i = 1; i < argc; ++i) {
+            profile<csv_parser>::reset();
+            ifstream in(argv[i], ios_base::in | ios_base::binary);
+            if (!in.is_open()) {
+                cerr << "unable to open " << argv[i] << "\n";
+                continue;
+            }
+            cout << argv[i] << "\n";
+            int const chars_read = parse(in);
+            profile_report const report = profile<csv_parser>::report();
+            cout << "parsed: " << report.mb_per_s(chars_read) << "MB/s\n" << report << "\n";
+            cout << report.per_mb(chars_read) << "\n";
+        }
+    }
+}
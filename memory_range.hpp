@@ -0,0 +1,111 @@
+#ifndef MEMORY_RANGE_HPP
+#define MEMORY_RANGE_HPP
+
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include "parser_combinators.hpp"
+
+extern "C" {
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+}
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+// Memory Range: parses a buffer already in memory, without copying it. The
+// iterator is a plain pointer, so the contiguous fast paths (vector scanning
+// in many and zero-copy spans) apply. The buffer must outlive the range and
+// any spans or errors that refer to it.
+
+class memory_range {
+public:
+    using iterator = char const*;
+
+    iterator const first;
+    iterator const last;
+
+    constexpr memory_range(char const* f, char const* l) : first(f), last(l) {}
+    constexpr memory_range(char const* f, size_t n) : first(f), last(f + n) {}
+    explicit memory_range(string const& s) : first(s.data()), last(s.data() + s.size()) {}
+
+    // a temporary string would not outlive the range.
+    explicit memory_range(string&&) = delete;
+};
+
+//----------------------------------------------------------------------------
+// Chunk Range: part of a larger buffer that starts at the beginning of a line,
+// parsed on its own (for example by one thread of a parallel parse). Errors
+// report lines and columns in the whole buffer; see parse_error.
+
+class chunk_range : public memory_range {
+public:
+    char const* const origin;
+
+    constexpr chunk_range(char const* o, char const* f, char const* l) : memory_range(f, l), origin(o) {}
+
+    pair<int, iterator> line_of(iterator const& i) const {
+        int const row = 1 + static_cast<int>(count(origin, i, '\n'));
+        reverse_iterator<iterator> const nl = find(reverse_iterator<iterator>(i),
+            reverse_iterator<iterator>(origin), '\n');
+        return make_pair(row, nl.base());
+    }
+};
+
+//----------------------------------------------------------------------------
+// Mapped File: maps a whole file read only, for parsing with memory_range or
+// chunk_range. Files that are not read front to back can pass other advice.
+
+class mapped_file {
+    char const* addr;
+    size_t len;
+
+public:
+    mapped_file(mapped_file const&) = delete;
+
+    explicit mapped_file(char const* name, int const advice = MADV_SEQUENTIAL) : addr(nullptr), len(0) {
+        int const fd = open(name, O_RDONLY);
+        if (fd < 0) {
+            throw runtime_error("unable to open file");
+        }
+        struct stat st;
+        if (fstat(fd, &st) < 0) {
+            close(fd);
+            throw runtime_error("unable to open file");
+        }
+        len = static_cast<size_t>(st.st_size);
+        if (len > 0) {
+            void* const m = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m == MAP_FAILED) {
+                close(fd);
+                throw runtime_error("unable to map file");
+            }
+            madvise(m, len, advice);
+            addr = static_cast<char const*>(m);
+        }
+        close(fd);
+    }
+
+    ~mapped_file() {
+        if (addr != nullptr) {
+            munmap(const_cast<char*>(addr), len);
+        }
+    }
+
+    char const* data() const {
+        return addr;
+    }
+
+    size_t size() const {
+        return len;
+    }
+};
+
+template <typename Synthesize = void, typename Inherit = default_inherited>
+using pmemory_handle = parser_handle<memory_range::iterator, memory_range, Synthesize, Inherit>;
+
+#endif // MEMORY_RANGE_HPP
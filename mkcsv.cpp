@@ -1,25 +1,44 @@
 #include <iostream>
-//#include <cstdlib>
-//#include <cstring>
+#include <string>
+
+#include "corpus.hpp"
 
 using namespace std;
 
-int main() {
-    int s = 0, s2 = 0, n = 0;
-    for (int i = 0; i < 10000; ++i) {
-        int t = 0;
-        for (int j = 0; j < 1000; ++ j) {
-            int const v = rand() % 10 + 1;
-            cout << v << ", ";
+//----------------------------------------------------------------------------
+// Writes rows of comma separated integers from 1 to 10, 10000 rows unless a
+// size is given. The checksum is the integer mean of the row sums, as printed
+// by the CSV drivers. An injected error replaces a value with 'x'.
+
+int main(int const argc, char const *argv[]) {
+    corpus_options opt(1001, 0);
+    if (!opt.parse(argc, argv, "size seed width space errors")) {
+        return 1;
+    }
+
+    corpus_random rnd(opt.seed);
+    corpus_output out(opt.out);
+    uint64_t const limit = opt.size_bytes();
+    int64_t s = 0, n = 0;
+    while ((limit > 0) ? out.size() < limit : n < 10000) {
+        int64_t t = 0;
+        for (int j = 0; j < opt.width; ++j) {
+            int const v = rnd.below(10) + 1;
+            if (rnd.chance(opt.errors)) {
+                out.error();
+                out.put('x');
+            } else {
+                out.put_int(v);
+            }
+            out.space(rnd, opt.space, false);
+            out.put((j + 1 < opt.width) ? ", " : "\n");
             t += v;
         }
-        int const v = rand() % 10 + 1;
-        cout << v << endl;
-        t += v;
         s += t;
         ++n;
-
     }
 
-    cerr << " = " << (s / n) << endl;
+    int64_t const checksum = (n == 0) ? 0 : s / n;
+    out.finish({{"rows", to_string(n)}, {"checksum", to_string(checksum)}});
+    cerr << " = " << checksum << endl;
 }
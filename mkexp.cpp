@@ -1,66 +1,117 @@
 #include <iostream>
-#include <cstdlib>
-#include <cstring>
+#include <string>
+#include <cstdint>
+#include <climits>
+
+#include "corpus.hpp"
 
 using namespace std;
 
-int expr(int depth, int max_depth) {
-    if (++depth > max_depth) {
-        int const v = rand() % 10 + 1;
-        cout << v;
-        return v;
-    }
+//----------------------------------------------------------------------------
+// Writes a fully bracketed random expression tree of the given depth, or the
+// shallowest one of at least the given size. The checksum is its value, with
+// the 32 bit wrapping arithmetic of the expression example. An injected error
+// replaces an operator with '?'.
+
+struct expression_writer {
+    corpus_options const& opt;
+    corpus_random rnd;
+    corpus_output& out;
 
-    cout << "(";
-    int const u = expr(depth, max_depth);
-    switch (rand() % 4) {
-        case 0: {
-            cout << " + ";
-            int const v = expr(depth, max_depth);
-            cout << ")";
-            return u + v;
+    expression_writer(corpus_options const& o, corpus_output& out) : opt(o), rnd(o.seed), out(out) {}
+
+    void op(char const c) {
+        out.put(' ');
+        if (rnd.chance(opt.errors)) {
+            out.error();
+            out.put('?');
+        } else {
+            out.put(c);
         }
+        out.put(' ');
+        out.space(rnd, opt.space);
+    }
+
+    void open() {
+        out.put('(');
+        out.space(rnd, opt.space);
+    }
+
+    void close() {
+        out.space(rnd, opt.space);
+        out.put(')');
+    }
+
+    // Writes " + 0" or " + 1", or " + 2" if dividing would overflow, so the
+    // divisor is never zero.
+    int32_t divisor(int32_t const u, int32_t const v) {
+        int32_t const d = (v == 0) ? 1 : (u == INT32_MIN && v == -1) ? 2 : 0;
+        op('+');
+        out.put_int(d);
+        close();
+        close();
+        return v + d;
+    }
 
-        case 1: {
-            cout << " - ";
-            int const v = expr(depth, max_depth);
-            cout << ")";
-            return u - v;
+    int32_t expr(int depth) {
+        if (++depth > opt.depth) {
+            int const v = rnd.below(10) + 1;
+            out.put_int(v);
+            return v;
         }
 
-        case 2: {
-            cout << " * (";
-            int const v = expr(depth, max_depth);
-            if (v == 0) {
-                cout << " + 1))";
-                return u * (v + 1);
-            } else {
-                cout << " + 0))";
-                return u * v;
+        open();
+        int32_t const u = expr(depth);
+        switch (rnd.below(4)) {
+            case 0: {
+                op('+');
+                int32_t const v = expr(depth);
+                close();
+                return static_cast<int32_t>(static_cast<uint32_t>(u) + static_cast<uint32_t>(v));
+            }
+
+            case 1: {
+                op('-');
+                int32_t const v = expr(depth);
+                close();
+                return static_cast<int32_t>(static_cast<uint32_t>(u) - static_cast<uint32_t>(v));
+            }
+
+            case 2: {
+                op('*');
+                open();
+                int32_t const v = expr(depth);
+                return static_cast<int32_t>(static_cast<uint32_t>(u) * static_cast<uint32_t>(divisor(u, v)));
             }
-            cout << ")";
-            return u * v;
-        }
 
-        default: {
-            cout << " / (";
-            int const v = expr(depth, max_depth);
-            if (v == 0) {
-                cout << " + 1))";
-                return u / (v + 1);
-            } else {
-                cout << " + 0))";
-                return u / v;
+            default: {
+                op('/');
+                open();
+                int32_t const v = expr(depth);
+                return u / divisor(u, v);
             }
         }
     }
-}
+};
+
+int main(int const argc, char const *argv[]) {
+    corpus_options opt(0, 12);
+    if (!opt.parse(argc, argv, "size seed depth space errors")) {
+        return 1;
+    }
 
-int main() {
-    int max_depth = 12;
-    int depth = 0;
+    // a tree of depth 'd' has 2^d leaves and averages about 9 bytes per leaf.
+    if (opt.size_bytes() > 0) {
+        opt.depth = 0;
+        while (opt.depth < 62 && (uint64_t(9) << opt.depth) < opt.size_bytes()) {
+            ++opt.depth;
+        }
+    }
 
-    int const v = expr(depth, max_depth);
-    cout << endl;
+    corpus_output out(opt.out);
+    expression_writer w(opt, out);
+    int32_t const v = w.expr(0);
+    out.put('\n');
+    out.finish({{"depth", to_string(opt.depth)}, {"checksum", to_string(v)}});
     cerr << " = " << v << endl;
 }
@@ -0,0 +1,139 @@
+#include <iostream>
+#include <string>
+
+#include "corpus.hpp"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+// Writes Prolog clauses for the logic parser: facts and rules over a small
+// set of predicates, with occasional queries, 1000 clauses unless a size is
+// given. Terms nest to the given depth, with the given maximum arity. The
+// expected result is the number of clauses and queries, as counted by the
+// prolog example. An injected error starts a clause with a digit.
+
+struct prolog_writer {
+    corpus_options const& opt;
+    corpus_random rnd;
+    corpus_output& out;
+
+    static int const predicates = 32;
+    static int const functors = 16;
+    static int const variables = 8;
+
+    prolog_writer(corpus_options const& o, corpus_output& out) : opt(o), rnd(o.seed), out(out) {}
+
+    void token(char const* s) {
+        out.put(s);
+        out.space(rnd, opt.space);
+    }
+
+    void name(char const c, int const n) {
+        out.put(c);
+        out.put_int(n);
+        out.space(rnd, opt.space);
+    }
+
+    void variable() {
+        if (rnd.below(8) == 0) {
+            token("_");
+        } else {
+            name('X', rnd.below(variables));
+        }
+    }
+
+    void args(int const depth) {
+        int const n = rnd.below(opt.width + 1);
+        if (n > 0) {
+            token("(");
+            for (int k = 0; k < n; ++k) {
+                if (k > 0) {
+                    token(", ");
+                }
+                term(depth + 1);
+            }
+            token(")");
+        }
+    }
+
+    void term(int const depth) {
+        if (depth >= opt.depth || rnd.below(3) == 0) {
+            if (rnd.below(2) == 0) {
+                variable();
+            } else {
+                name('a', rnd.below(functors));
+            }
+        } else {
+            name('f', rnd.below(functors));
+            args(depth);
+        }
+    }
+
+    void goal() {
+        if (rnd.below(4) == 0) {
+            variable();
+            token(" = ");
+            term(1);
+        } else {
+            name('p', rnd.below(predicates));
+            args(0);
+        }
+    }
+
+    void goals() {
+        token(" :- ");
+        for (int n = rnd.below(3); n >= 0; --n) {
+            goal();
+            if (n > 0) {
+                token(", ");
+            }
+        }
+    }
+
+    // Writes a clause or a query, returning true for a query.
+    bool clause() {
+        if (rnd.chance(opt.comments)) {
+            out.put("# generated comment ");
+            out.put_int(static_cast<int64_t>(rnd.below(1000000)));
+            out.put('\n');
+        }
+        if (rnd.chance(opt.errors)) {
+            out.error();
+            out.put('9');
+        }
+        bool const query = rnd.below(20) == 0;
+        if (query) {
+            goals();
+        } else {
+            name('p', rnd.below(predicates));
+            args(0);
+            if (rnd.below(2) == 0) {
+                goals();
+            }
+        }
+        out.put(".\n");
+        return query;
+    }
+};
+
+int main(int const argc, char const *argv[]) {
+    corpus_options opt(3, 3);
+    if (!opt.parse(argc, argv, "size seed width depth space comments errors")) {
+        return 1;
+    }
+
+    corpus_output out(opt.out);
+    prolog_writer w(opt, out);
+    uint64_t const limit = opt.size_bytes();
+    int64_t clauses = 0, queries = 0;
+    while ((limit > 0) ? out.size() < limit : clauses + queries < 1000) {
+        if (w.clause()) {
+            ++queries;
+        } else {
+            ++clauses;
+        }
+    }
+
+    out.finish({{"clauses", to_string(clauses)}, {"goals", to_string(queries)}});
+    cerr << " = " << clauses << " clauses, " << queries << " goals" << endl;
+}
@@ -0,0 +1,375 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <exception>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "memory_range.hpp"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+// Parallel For: runs f(0) ... f(n - 1) on up to 'threads' threads. Each thread
+// starts with a contiguous block of indices and takes them from the front;
+// a thread that runs out steals the back half of another thread's block, so
+// uneven work balances without a shared queue. If calls throw, the exception
+// from the lowest index is rethrown once all threads have finished.
+
+class work_stealing {
+    // padded so threads do not share cache lines.
+    struct block {
+        mutex m;
+        size_t begin;
+        size_t end;
+        char pad[64];
+    };
+
+    vector<block> blocks;
+
+    bool take(size_t const t, size_t& k) {
+        {
+            lock_guard<mutex> lock(blocks[t].m);
+            if (blocks[t].begin < blocks[t].end) {
+                k = blocks[t].begin++;
+                return true;
+            }
+        }
+        for (size_t v = (t + 1) % blocks.size(); v != t; v = (v + 1) % blocks.size()) {
+            size_t b, e;
+            {
+                lock_guard<mutex> lock(blocks[v].m);
+                if (blocks[v].begin >= blocks[v].end) {
+                    continue;
+                }
+                b = blocks[v].begin + (blocks[v].end - blocks[v].begin) / 2;
+                e = blocks[v].end;
+                blocks[v].end = b;
+            }
+            lock_guard<mutex> lock(blocks[t].m);
+            k = b;
+            blocks[t].begin = b + 1;
+            blocks[t].end = e;
+            return true;
+        }
+        return false;
+    }
+
+public:
+    work_stealing(size_t const n, size_t const threads) : blocks(max<size_t>(1, min(threads, n))) {
+        size_t const t = blocks.size();
+        for (size_t i = 0; i < t; ++i) {
+            blocks[i].begin = n * i / t;
+            blocks[i].end = n * (i + 1) / t;
+        }
+    }
+
+    template <typename F> void run(F const& f) {
+        vector<exception_ptr> errors(blocks.size());
+        vector<size_t> error_at(blocks.size());
+        auto const worker = [this, &f, &errors, &error_at] (size_t const t) {
+            size_t k;
+            while (take(t, k)) {
+                try {
+                    f(k);
+                } catch (...) {
+                    if (!errors[t] || k < error_at[t]) {
+                        errors[t] = current_exception();
+                        error_at[t] = k;
+                    }
+                }
+            }
+        };
+
+        vector<thread> pool;
+        for (size_t t = 1; t < blocks.size(); ++t) {
+            pool.emplace_back(worker, t);
+        }
+        worker(0);
+        for (thread& t : pool) {
+            t.join();
+        }
+
+        exception_ptr first;
+        size_t first_at = 0;
+        for (size_t t = 0; t < errors.size(); ++t) {
+            if (errors[t] && (!first || error_at[t] < first_at)) {
+                first = errors[t];
+                first_at = error_at[t];
+            }
+        }
+        if (first) {
+            rethrow_exception(first);
+        }
+    }
+};
+
+template <typename F> void parallel_for(size_t const n, size_t const threads, F const& f) {
+    if (n > 0) {
+        work_stealing(n, threads).run(f);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Split Records: cuts a buffer into about 'n' chunks that each start just
+// after a newline, so the chunks can be parsed independently. A newline is
+// only a safe cut if every parse of the whole buffer ends a record there:
+// grammars that skip newlines as whitespace may continue a record over it
+// ("1,\n2" is one CSV record). 'is_break(f, nl, l)' says whether the newline
+// at 'nl' in [f, l) always ends a record; split_lines cuts at every newline,
+// for grammars where newlines end records.
+
+struct any_newline {
+    constexpr any_newline() {}
+    constexpr bool operator() (char const*, char const*, char const*) const {
+        return true;
+    }
+} constexpr any_newline;
+
+template <typename Break>
+vector<chunk_range> split_records(char const* const f, char const* const l, size_t const n, Break const& is_break) {
+    vector<chunk_range> chunks;
+    size_t const size = static_cast<size_t>(l - f);
+    char const* begin = f;
+    for (size_t i = 1; i <= n && begin != l; ++i) {
+        char const* end = f + size * i / n;
+        if (end < begin) {
+            end = begin;
+        }
+        while (end != l) {
+            void const* const nl = memchr(end, '\n', static_cast<size_t>(l - end));
+            if (nl == nullptr) {
+                end = l;
+            } else {
+                char const* const at = static_cast<char const*>(nl);
+                end = at + 1;
+                if (is_break(f, at, l)) {
+                    break;
+                }
+            }
+        }
+        if (end != begin) {
+            chunks.emplace_back(f, begin, end);
+            begin = end;
+        }
+    }
+    return chunks;
+}
+
+inline vector<chunk_range> split_lines(char const* const f, char const* const l, size_t const n) {
+    return split_records(f, l, n, any_newline);
+}
+
+//----------------------------------------------------------------------------
+// Parallel Many: parses {item} like many, splitting contiguous input between
+// threads. The input is cut into chunks at guessed starts, each just after a
+// resync point: a symbol matching a predicate, or the end of a match of a
+// parser. Every chunk parses items until it reaches the next chunk's start.
+// A chunk is used only if the previous one ended exactly where it begins,
+// otherwise the guess was wrong (an item spans the resync point) and that
+// part is parsed again sequentially. Errors from chunks that are not used are
+// ignored, so the result and any error are those of a sequential parse.
+//
+// Items cannot use inherited attributes, as chunks are parsed concurrently
+// and one inherited state would be shared between them. This rules out loops
+// whose items build shared state, like the Prolog parser's clauses, which
+// intern atoms and append cells to one program. Items cannot be memoized
+// either, as the copies of a memoized parser share one table; this is checked
+// for memo and memo_fix in the item's type, but not behind a parser handle.
+// The per chunk results are joined in order by par_merge, which is defined
+// for vectors and strings and can be specialised for other accumulating
+// results. Other iterators are parsed sequentially.
+
+template <typename Result> struct par_merge;
+
+template <typename T, typename A> struct par_merge<vector<T, A>> {
+    static void append(vector<T, A>& into, vector<T, A>& from) {
+        into.insert(into.end(), make_move_iterator(from.begin()), make_move_iterator(from.end()));
+    }
+};
+
+template <> struct par_merge<string> {
+    static void append(string& into, string& from) {
+        into.append(from);
+    }
+};
+
+template <typename Result> struct par_result {
+    Result value;
+
+    Result* get(Result const* into) {
+        return (into == nullptr) ? nullptr : &value;
+    }
+
+    void merge(Result* into) {
+        if (into != nullptr) {
+            par_merge<Result>::append(*into, value);
+        }
+    }
+};
+
+template <> struct par_result<void> {
+    void* get(void const*) {
+        return nullptr;
+    }
+
+    void merge(void*) {}
+};
+
+// Whether a parser's type has a memoized parser in it.
+template <typename P> struct has_memo;
+
+template <typename... Ps> struct any_memo : false_type {};
+template <typename P, typename... Ps> struct any_memo<P, Ps...>
+    : integral_constant<bool, has_memo<P>::value || any_memo<Ps...>::value> {};
+
+template <typename P> struct has_memo : false_type {};
+template <typename P> struct has_memo<P const> : has_memo<P> {};
+template <template <typename...> class C, typename... Ps> struct has_memo<C<Ps...>> : any_memo<Ps...> {};
+template <typename P> struct has_memo<parser_memo<P>> : true_type {};
+
+template <typename P, typename = void> struct is_predicate : false_type {};
+template <typename P> struct is_predicate<P, typename enable_if<P::is_predicate_type::value>::type> : true_type {};
+
+template <typename Parser, typename Resync> class combinator_par_many {
+    Parser const p;
+    Resync const q;
+    size_t const threads;
+
+    // input per chunk at least, and chunks per thread at most.
+    static size_t const min_chunk = 1 << 16;
+    static size_t const chunks_per_thread = 4;
+
+    template <typename Iterator, typename Range>
+    Iterator resync_after(Iterator s, Range const &r, true_type) const {
+        while (s != r.last && !q(static_cast<unsigned char>(*s))) {
+            ++s;
+        }
+        return (s == r.last) ? s : ++s;
+    }
+
+    template <typename Iterator, typename Range>
+    Iterator resync_after(Iterator s, Range const &r, false_type) const {
+        for (; s != r.last; ++s) {
+            Iterator j = s;
+            if (q(j, r) && j != s) {
+                return j;
+            }
+        }
+        return s;
+    }
+
+    // Items from 'i' until one fails, or 'i' reaches 'limit'.
+    template <typename Iterator, typename Range, typename Result>
+    void items(Iterator &i, Range const &r, Result *result, default_inherited* st, Iterator const& limit) const {
+        Iterator first = i;
+        while (i < limit && p(i, r, result, st)) {
+            first = i;
+        }
+        if (first != i) {
+            throw parse_error("failed many-parser consumed input", p, first, i, r);
+        }
+    }
+
+    template <typename Iterator, typename Range>
+    bool parse(Iterator &i, Range const &r, typename Parser::result_type *result, default_inherited* st, false_type) const {
+        return combinator_many<Parser>(p)(i, r, result, st);
+    }
+
+    template <typename Iterator, typename Range>
+    bool parse(Iterator &i, Range const &r, typename Parser::result_type *result, default_inherited* st, true_type) const {
+        size_t const size = static_cast<size_t>(r.last - i);
+        size_t const n = min(threads * chunks_per_thread, size / min_chunk);
+        if (n < 2) {
+            items(i, r, result, st, r.last);
+            return true;
+        }
+
+        vector<Iterator> starts {i};
+        for (size_t k = 1; k < n; ++k) {
+            Iterator const s = resync_after(max(i + size * k / n, starts.back()), r, is_predicate<Resync>());
+            if (s != r.last && starts.back() < s) {
+                starts.push_back(s);
+            }
+        }
+        starts.push_back(r.last);
+
+        struct piece {
+            Iterator end;
+            par_result<typename Parser::result_type> value;
+            exception_ptr error;
+        };
+        vector<piece> pieces(starts.size() - 1);
+        parallel_for(pieces.size(), threads, [this, &r, &starts, &pieces, result, st] (size_t const k) {
+            Iterator j = starts[k];
+            try {
+                items(j, r, pieces[k].value.get(result), st, starts[k + 1]);
+            } catch (...) {
+                pieces[k].error = current_exception();
+            }
+            pieces[k].end = j;
+        });
+
+        for (size_t k = 0; k < pieces.size(); ++k) {
+            if (i == starts[k]) {
+                if (pieces[k].error) {
+                    rethrow_exception(pieces[k].error);
+                }
+                pieces[k].value.merge(result);
+                i = pieces[k].end;
+            } else {
+                items(i, r, result, st, starts[k + 1]);
+            }
+            if (i < starts[k + 1]) {
+                break;
+            }
+        }
+        return true;
+    }
+
+public:
+    using is_parser_type = true_type;
+    using is_handle_type = false_type;
+    using has_side_effects = typename Parser::has_side_effects;
+    using result_type = typename Parser::result_type;
+    int const rank = 0;
+
+    constexpr combinator_par_many(Parser const& p, Resync const& q, size_t const threads)
+        : p(p), q(q), threads(threads) {}
+
+    template <typename Iterator, typename Range, typename Inherit = default_inherited>
+    bool operator() (
+        Iterator &i,
+        Range const &r,
+        result_type *result = nullptr,
+        Inherit* st = nullptr
+    ) const {
+        static_assert(is_same<Inherit, default_inherited>::value,
+            "par_many items cannot depend on inherited attributes");
+        static_assert(!has_memo<Parser>::value,
+            "par_many items cannot be memoized");
+        return parse(i, r, result, st, is_contiguous<Iterator>());
+    }
+
+    constexpr first_set first() const {
+        return first_of(p).optional();
+    }
+
+    string ebnf(unique_defs* defs = nullptr) const {
+        return "{" + p.ebnf(defs) + "}";
+    }
+};
+
+template <typename P, typename Q, typename = typename enable_if<is_same<typename P::is_parser_type, true_type>::value
+    || is_same<typename P::is_handle_type, true_type>::value>::type>
+combinator_par_many<P, Q> const par_many(P const& p, Q const& q,
+    size_t const threads = max(1u, thread::hardware_concurrency())
+) {
+    return combinator_par_many<P, Q>(p, q, threads);
+}
+
+#endif // PARALLEL_HPP
@@ -6,6 +6,11 @@
 #ifndef PARSER_COMBINATORS_HPP
 #define PARSER_COMBINATORS_HPP
 
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
 #include <istream>
 #include <sstream>
 #include <stdexcept>
@@ -20,16 +25,38 @@
 #include <type_traits>
 #include "function_traits.hpp"
 
+#if defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+
+#ifdef PROFILE_RULES
+#include <iomanip>
+#include <iostream>
+#endif
+
 using namespace std;
 
 //============================================================================
 // Character Predicates
+//
+// Symbols are unsigned char values or EOF. The classifications are those of
+// the "C" locale, written out so that predicates can be evaluated at compile
+// time and folded into a char_set by the recognisers.
 
 struct is_any {
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr is_any() {};
-    bool operator() (int const c) const {
+    constexpr bool operator() (int const c) const {
         return c != EOF;
     }
     string name() const {
@@ -41,8 +68,8 @@ struct is_alnum {
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr is_alnum() {}
-    bool operator() (int const c) const {
-        return ::isalnum(c) != 0;
+    constexpr bool operator() (int const c) const {
+        return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
     }
     string name() const {
         return "alphanumeric";
@@ -53,8 +80,8 @@ struct is_alpha {
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr is_alpha() {}
-    bool operator() (int const c) const {
-        return ::isalpha(c) != 0;
+    constexpr bool operator() (int const c) const {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
     }
     string name() const {
         return "alphabetic";
@@ -65,8 +92,8 @@ struct is_blank {
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr is_blank() {}
-    bool operator() (int const c) const {
-        return ::isblank(c) != 0;
+    constexpr bool operator() (int const c) const {
+        return c == ' ' || c == '\t';
     }
     string name() const {
         return "blank";
@@ -77,8 +104,8 @@ struct is_cntrl {
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr is_cntrl() {}
-    bool operator() (int const c) const {
-        return ::iscntrl(c) != 0;
+    constexpr bool operator() (int const c) const {
+        return (c >= 0 && c < ' ') || c == 127;
     }
     string name() const {
         return "control";
@@ -89,8 +116,8 @@ struct is_digit {
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr is_digit() {}
-    bool operator() (int const c) const {
-        return ::isdigit(c) != 0;
+    constexpr bool operator() (int const c) const {
+        return c >= '0' && c <= '9';
     }
     string name() const {
         return "digit";
@@ -101,8 +128,8 @@ struct is_graph {
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr is_graph() {}
-    bool operator() (int const c) const {
-        return ::isgraph(c) != 0;
+    constexpr bool operator() (int const c) const {
+        return c > ' ' && c < 127;
     }
     string name() const {
         return "graphic";
@@ -113,8 +140,8 @@ struct is_lower {
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr is_lower() {}
-    bool operator() (int const c) const {
-        return ::islower(c) != 0;
+    constexpr bool operator() (int const c) const {
+        return c >= 'a' && c <= 'z';
     }
     string name() const {
         return "lowercase";
@@ -125,8 +152,8 @@ struct is_print {
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr is_print() {}
-    bool operator() (int const c) const {
-        return ::isprint(c) != 0;
+    constexpr bool operator() (int const c) const {
+        return c >= ' ' && c < 127;
     }
     string name() const {
         return "printable";
@@ -137,8 +164,8 @@ struct is_punct {
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr is_punct() {}
-    bool operator() (int const c) const {
-        return ::ispunct(c) != 0;
+    constexpr bool operator() (int const c) const {
+        return c > ' ' && c < 127 && !((c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'));
     }
     string name() const {
         return "punctuation";
@@ -149,8 +176,8 @@ struct is_space {
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr is_space() {}
-    bool operator() (int const c) const {
-        return ::isspace(c) != 0;
+    constexpr bool operator() (int const c) const {
+        return c == ' ' || (c >= '\t' && c <= '\r');
     }
     string name() const {
         return "space";
@@ -161,8 +188,8 @@ struct is_upper {
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr is_upper() {}
-    bool operator() (int const c) const {
-        return ::isupper(c) != 0;
+    constexpr bool operator() (int const c) const {
+        return c >= 'A' && c <= 'Z';
     }
     string name() const {
         return "uppercase";
@@ -173,8 +200,8 @@ struct is_xdigit {
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr is_xdigit() {}
-    bool operator() (int const c) const {
-        return ::isxdigit(c) != 0;
+    constexpr bool operator() (int const c) const {
+        return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f');
     }
     string name() const {
         return "hexdigit";
@@ -185,7 +212,7 @@ struct is_eol {
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr is_eol() {}
-    bool operator() (int const c) const {
+    constexpr bool operator() (int const c) const {
         return c == '\n';
     }
     string name() const {
@@ -194,7 +221,8 @@ struct is_eol {
 } constexpr is_eol;
 
 //----------------------------------------------------------------------------
-// Any single character
+// Any single character. A char is taken as the byte it holds, so '\xff' is
+// the byte 0xff even where char is signed; an int is a byte 0-255 or EOF.
 
 class is_char {
     int const k;
@@ -203,8 +231,10 @@ public:
     using is_predicate_type = true_type;
     static constexpr int rank = 0;
     constexpr explicit is_char(char const c)
-        : k(c) {}
-    bool operator() (int const c) const {
+        : k(static_cast<unsigned char>(c)) {}
+    constexpr explicit is_char(int const c)
+        : k((c == EOF) ? EOF : (c & 0xff)) {}
+    constexpr bool operator() (int const c) const {
         return k == c;
     }
     string name() const {
@@ -235,7 +265,7 @@ public:
     static constexpr int rank = 1;
     constexpr is_either(P1 const& p1, P2 const& p2)
         : p1(p1), p2(p2) {}
-    bool operator() (int const c) const {
+    constexpr bool operator() (int const c) const {
         return p1(c) || p2(c);
     }
     string name() const {
@@ -261,7 +291,7 @@ public:
     static constexpr int rank = 0;
     constexpr explicit is_except(P1 const& p1, P2 const& p2) 
         : p1(p1), p2(p2) {}
-    bool operator() (int const c) const {
+    constexpr bool operator() (int const c) const {
         return p1(c) && !p2(c);
     }
     string name() const {
@@ -281,6 +311,408 @@ constexpr is_except<P1, P2> const operator- (P1 const& p1, P2 const& p2) {
 
 struct default_inherited {};
 
+//===========================================================================
+// Backtrack Window
+
+//----------------------------------------------------------------------------
+// Input is only rewound or re-read from the start of a live backtrack frame.
+// attempt opens one, as do parsers that re-read what they consumed. The start
+// of the outermost frame is the lowest position that can be read again; with
+// no frame live nothing before the current position can. Memoized parsers use
+// it to evict entries, and buffered ranges to discard input. The window is per
+// thread, positions are offsets from the start of the range.
+
+struct backtrack_window {
+    int depth;
+    ptrdiff_t floor;
+
+    static backtrack_window& current() {
+        static thread_local backtrack_window w {0, 0};
+        return w;
+    }
+
+    ptrdiff_t low_mark(ptrdiff_t const pos) const {
+        return (depth == 0) ? pos : floor;
+    }
+
+    class frame {
+        backtrack_window& w;
+
+    public:
+        explicit frame(ptrdiff_t const pos) : w(current()) {
+            if (w.depth++ == 0) {
+                w.floor = pos;
+            }
+        }
+
+        ~frame() {
+            --w.depth;
+        }
+    };
+};
+
+//===========================================================================
+// Parser Trace
+//
+// A runtime switchable trace of rule events (see rule_scope): enter, exit,
+// fail, and backtrack (a failure that consumed input). Each thread appends
+// fixed size records to a ring buffer it owns, without locking, keeping the
+// most recent events when it wraps. Records hold the rule's name pointer,
+// which write() turns into an index, so recording an event is a clock read
+// and a store. With tracing stopped each event costs one test of a flag.
+//
+// start() begins a new generation: the registry lets go of the old rings,
+// and each thread replaces its ring at its next event, so a thread still
+// writing to an old ring keeps it alive. Rings of threads that have exited
+// are kept until the next start(). write() saves the rule names and the rings
+// of the current generation, each with a thread number that stays the same
+// for the life of the thread, in a binary format that trace2json converts to
+// Chrome trace JSON. Rings are only read consistently while no thread is
+// parsing.
+
+enum trace_kind : uint32_t {trace_enter, trace_exit, trace_fail, trace_backtrack};
+
+struct trace_record {
+    uint64_t time_ns;
+    int64_t offset;
+    uint32_t rule;
+    uint32_t kind;
+};
+
+template <typename = void> class basic_parser_trace {
+    struct event {
+        uint64_t time_ns;
+        int64_t offset;
+        char const* name;
+        uint32_t kind;
+    };
+
+    struct ring {
+        uint32_t const thread;
+        uint64_t const generation;
+        size_t const mask;
+        vector<event> events;
+        atomic<uint64_t> head;
+
+        ring(uint32_t t, uint64_t g, size_t capacity)
+            : thread(t), generation(g), mask(capacity - 1), events(capacity), head(0) {}
+    };
+
+    struct registry {
+        mutex m;
+        vector<shared_ptr<ring>> rings;
+        uint32_t threads;
+        size_t capacity;
+
+        registry() : threads(0), capacity(1 << 18) {}
+    };
+
+    static atomic<bool> enabled;
+    static atomic<uint64_t> generation;
+
+    static registry& all() {
+        static registry r;
+        return r;
+    }
+
+    static ring& local() {
+        static thread_local shared_ptr<ring> t;
+        static thread_local uint32_t thread = numeric_limits<uint32_t>::max();
+        if (!t || t->generation != generation.load(memory_order_acquire)) {
+            registry& r = all();
+            lock_guard<mutex> lock(r.m);
+            if (thread == numeric_limits<uint32_t>::max()) {
+                thread = r.threads++;
+            }
+            t = make_shared<ring>(thread, generation.load(memory_order_relaxed), r.capacity);
+            r.rings.push_back(t);
+        }
+        return *t;
+    }
+
+public:
+    static bool on() {
+        return enabled.load(memory_order_relaxed);
+    }
+
+    // Discards earlier traces; 'capacity' is per thread, rounded up to a power of two.
+    static void start(size_t const capacity = 1 << 18) {
+        registry& r = all();
+        lock_guard<mutex> lock(r.m);
+        r.capacity = 1;
+        while (r.capacity < capacity) {
+            r.capacity <<= 1;
+        }
+        r.rings.clear();
+        generation.fetch_add(1, memory_order_release);
+        enabled.store(true, memory_order_relaxed);
+    }
+
+    static void stop() {
+        enabled.store(false, memory_order_relaxed);
+    }
+
+    static void record(trace_kind const kind, char const* name, ptrdiff_t const offset) {
+        ring& t = local();
+        uint64_t const h = t.head.load(memory_order_relaxed);
+        event& e = t.events[h & t.mask];
+        e.time_ns = chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count();
+        e.offset = offset;
+        e.name = name;
+        e.kind = kind;
+        t.head.store(h + 1, memory_order_release);
+    }
+
+    // "PCTRACE1", the rule names, then each thread's number and records
+    // oldest first.
+    static void write(ostream& out) {
+        registry& r = all();
+        lock_guard<mutex> lock(r.m);
+        unordered_map<char const*, uint32_t> ids;
+        vector<char const*> names;
+        for (shared_ptr<ring> const& t : r.rings) {
+            uint64_t const h = t->head.load(memory_order_acquire);
+            for (uint64_t k = h - min<uint64_t>(h, t->events.size()); k != h; ++k) {
+                char const* const n = t->events[k & t->mask].name;
+                if (ids.emplace(n, static_cast<uint32_t>(names.size())).second) {
+                    names.push_back(n);
+                }
+            }
+        }
+
+        out.write("PCTRACE1", 8);
+        uint32_t const count = static_cast<uint32_t>(names.size());
+        out.write(reinterpret_cast<char const*>(&count), sizeof(count));
+        for (char const* n : names) {
+            uint32_t const len = static_cast<uint32_t>(strlen(n));
+            out.write(reinterpret_cast<char const*>(&len), sizeof(len));
+            out.write(n, len);
+        }
+        uint32_t const threads = static_cast<uint32_t>(r.rings.size());
+        out.write(reinterpret_cast<char const*>(&threads), sizeof(threads));
+        for (shared_ptr<ring> const& t : r.rings) {
+            uint64_t const h = t->head.load(memory_order_acquire);
+            uint64_t const n = min<uint64_t>(h, t->events.size());
+            out.write(reinterpret_cast<char const*>(&t->thread), sizeof(t->thread));
+            out.write(reinterpret_cast<char const*>(&n), sizeof(n));
+            for (uint64_t k = h - n; k != h; ++k) {
+                event const& e = t->events[k & t->mask];
+                trace_record const x {e.time_ns, e.offset, ids[e.name], e.kind};
+                out.write(reinterpret_cast<char const*>(&x), sizeof(x));
+            }
+        }
+    }
+};
+
+template <typename T> atomic<bool> basic_parser_trace<T>::enabled {false};
+template <typename T> atomic<uint64_t> basic_parser_trace<T>::generation {0};
+
+using parser_trace = basic_parser_trace<>;
+
+//===========================================================================
+// Rule Profiling
+//
+// Built with PROFILE_RULES, every define, fix and named reference records
+// calls, successes, failures, backtracks (failures that consumed input),
+// inclusive and exclusive time and the bytes consumed by successful calls.
+// Exclusive time leaves out the named rules called from a rule; inclusive
+// time counts a recursive rule once, at its outermost call. Counters are per
+// thread and summed by name in the report, which is sorted by exclusive time
+// and written to cerr at exit, or on demand with rule_profile::report. With
+// alloc_tracker.hpp, allocations are charged to the innermost running rule.
+// Without PROFILE_RULES the rule scopes only emit trace events.
+
+#ifdef PROFILE_RULES
+
+struct rule_stats {
+    string name;
+    uint64_t calls;
+    uint64_t successes;
+    uint64_t failures;
+    uint64_t backtracks;
+    uint64_t inclusive_ns;
+    uint64_t exclusive_ns;
+    uint64_t bytes;
+    uint64_t allocations;
+    uint64_t allocated_bytes;
+    int active;
+
+    explicit rule_stats(string const& n) : name(n), calls(0), successes(0), failures(0),
+        backtracks(0), inclusive_ns(0), exclusive_ns(0), bytes(0), allocations(0), allocated_bytes(0),
+        active(0) {}
+};
+
+class rule_profile {
+    mutex m;
+    deque<rule_stats> stats;
+
+    rule_profile() {}
+
+    ~rule_profile() {
+        if (!stats.empty()) {
+            write(cerr);
+        }
+    }
+
+    void write(ostream& out) {
+        lock_guard<mutex> lock(m);
+        map<string, rule_stats> totals;
+        for (rule_stats const& s : stats) {
+            rule_stats& t = totals.emplace(s.name, rule_stats(s.name)).first->second;
+            t.calls += s.calls;
+            t.successes += s.successes;
+            t.failures += s.failures;
+            t.backtracks += s.backtracks;
+            t.inclusive_ns += s.inclusive_ns;
+            t.exclusive_ns += s.exclusive_ns;
+            t.bytes += s.bytes;
+            t.allocations += s.allocations;
+            t.allocated_bytes += s.allocated_bytes;
+        }
+        vector<rule_stats const*> rows;
+        for (auto const& t : totals) {
+            rows.push_back(&t.second);
+        }
+        sort(rows.begin(), rows.end(), [] (rule_stats const* a, rule_stats const* b) {
+            return a->exclusive_ns > b->exclusive_ns;
+        });
+
+        out << left << setw(24) << "rule" << right << setw(12) << "calls" << setw(12) << "success"
+            << setw(12) << "fail" << setw(12) << "backtrack" << setw(12) << "incl ms"
+            << setw(12) << "excl ms" << setw(14) << "bytes" << setw(10) << "bytes/ok"
+            << setw(12) << "allocs" << setw(14) << "alloc bytes" << "\n";
+        for (rule_stats const* s : rows) {
+            out << left << setw(24) << s->name << right << setw(12) << s->calls << setw(12) << s->successes
+                << setw(12) << s->failures << setw(12) << s->backtracks
+                << setw(12) << fixed << setprecision(3) << s->inclusive_ns / 1e6
+                << setw(12) << s->exclusive_ns / 1e6 << setw(14) << s->bytes
+                << setw(10) << setprecision(1) << ((s->successes == 0) ? 0.0 : double(s->bytes) / s->successes)
+                << setw(12) << s->allocations << setw(14) << s->allocated_bytes << "\n";
+        }
+        out.unsetf(ios_base::floatfield);
+    }
+
+    static rule_profile& instance() {
+        static rule_profile p;
+        return p;
+    }
+
+public:
+    // The calling thread's counters for a rule, keyed by the name's address.
+    static rule_stats& get(char const* name) {
+        static thread_local unordered_map<char const*, rule_stats*> cache;
+        rule_stats*& s = cache[name];
+        if (s == nullptr) {
+            rule_profile& p = instance();
+            lock_guard<mutex> lock(p.m);
+            p.stats.emplace_back(name);
+            s = &p.stats.back();
+        }
+        return *s;
+    }
+
+    // Report and reset while no parse is running.
+    static void report(ostream& out = cerr) {
+        instance().write(out);
+    }
+
+    static void reset() {
+        rule_profile& p = instance();
+        lock_guard<mutex> lock(p.m);
+        for (rule_stats& s : p.stats) {
+            s = rule_stats(s.name);
+        }
+    }
+};
+
+class rule_scope {
+    using clock = chrono::steady_clock;
+
+    char const* const name;
+    rule_stats& s;
+    rule_scope* const parent;
+    ptrdiff_t const start;
+    clock::time_point const t;
+    uint64_t children;
+    bool success;
+    ptrdiff_t end;
+
+    static rule_scope*& top() {
+        static thread_local rule_scope* t = nullptr;
+        return t;
+    }
+
+public:
+    // The counters of the innermost rule running on this thread, if any.
+    static rule_stats* current() {
+        rule_scope* const t = top();
+        return (t == nullptr) ? nullptr : &t->s;
+    }
+
+    rule_scope(char const* n, ptrdiff_t const pos) : name(n), s(rule_profile::get(n)), parent(top()),
+        start(pos), t(clock::now()), children(0), success(false), end(pos) {
+        ++s.calls;
+        ++s.active;
+        top() = this;
+        if (parser_trace::on()) {
+            parser_trace::record(trace_enter, name, pos);
+        }
+    }
+
+    void done(bool const b, ptrdiff_t const pos) {
+        success = b;
+        end = pos;
+        if (parser_trace::on()) {
+            parser_trace::record(b ? trace_exit : (pos != start) ? trace_backtrack : trace_fail, name, pos);
+        }
+    }
+
+    // Runs on exceptions too, which count as failures.
+    ~rule_scope() {
+        uint64_t const ns = chrono::duration_cast<chrono::nanoseconds>(clock::now() - t).count();
+        top() = parent;
+        if (parent != nullptr) {
+            parent->children += ns;
+        }
+        s.exclusive_ns += ns - min(ns, children);
+        if (--s.active == 0) {
+            s.inclusive_ns += ns;
+        }
+        if (success) {
+            ++s.successes;
+            s.bytes += end - start;
+        } else {
+            ++s.failures;
+            if (end != start) {
+                ++s.backtracks;
+            }
+        }
+    }
+};
+
+#else // PROFILE_RULES
+
+class rule_scope {
+    char const* const name;
+    ptrdiff_t const start;
+
+public:
+    rule_scope(char const* n, ptrdiff_t const pos) : name(n), start(pos) {
+        if (parser_trace::on()) {
+            parser_trace::record(trace_enter, name, pos);
+        }
+    }
+
+    void done(bool const b, ptrdiff_t const pos) {
+        if (parser_trace::on()) {
+            parser_trace::record(b ? trace_exit : (pos != start) ? trace_backtrack : trace_fail, name, pos);
+        }
+    }
+};
+
+#endif // PROFILE_RULES
+
 //===========================================================================
 // Parsing Errors
 
@@ -288,12 +720,15 @@ using unique_defs = map<string, string>;
 
 struct parse_error : public runtime_error {
 
-    template <typename Parser, typename Iterator, typename Range>
-    static string message(string const& what, Parser const& p,
-        Iterator const &f, Iterator const &l, Range const &r
-    ) {
-        stringstream err;
+    // The row of 'f' and the start of its line. Ranges that discard consumed
+    // input provide 'line_of', otherwise lines are counted from the start.
+    template <typename Iterator, typename Range>
+    static auto line_of(Iterator const &f, Range const &r, int) -> decltype(r.line_of(f)) {
+        return r.line_of(f);
+    }
 
+    template <typename Iterator, typename Range>
+    static pair<int, Iterator> line_of(Iterator const &f, Range const &r, long) {
         Iterator i(r.first);
         Iterator line_start(r.first);
         int row = 1;
@@ -305,6 +740,19 @@ struct parse_error : public runtime_error {
                 ++i;
             }
         }
+        return make_pair(row, line_start);
+    }
+
+    template <typename Parser, typename Iterator, typename Range>
+    static string message(string const& what, Parser const& p,
+        Iterator const &f, Iterator const &l, Range const &r
+    ) {
+        stringstream err;
+
+        pair<int, Iterator> const line = line_of(f, r, 0);
+        int const row = line.first;
+        Iterator const& line_start = line.second;
+        Iterator i(line_start);
 
         err << what << " at line: " << row
             << " column: " << f - line_start + 1 << endl;
@@ -329,9 +777,8 @@ struct parse_error : public runtime_error {
         }
 
         err << '^';
-        ++i;
 
-        if (i != l) {
+        if (i != l && ++i != l) {
             ++i;
             while (i != l) {
                 err << '-';
@@ -444,38 +891,353 @@ string format_name(P const& p, int const rank, unique_defs* defs = nullptr) {
     }
 }
 
+//============================================================================
+// Character Sets
+//
+// A predicate expression is folded into a 256 bit table when a recogniser is
+// constructed, so testing a symbol is a single indexed load however the
+// predicate was composed. EOF is not a byte, so it gets its own flag.
+//
+// The table is laid out by nibble: byte 'lo' holds the bits for the symbols
+// with low nibble 'lo' and high nibble 0-7, byte '16 + lo' those with high
+// nibble 8-15. This lets 'scan' classify a whole vector of symbols with two
+// byte shuffles, which is how many(accept(...)) runs over contiguous input.
+
+class char_set {
+    uint8_t const bits[32];
+    bool const eof;
+
+    template <typename P>
+    static constexpr uint8_t byte(P const& p, int const e, int const n) {
+        return (n == 8) ? 0 : ((p((((e >> 4) << 3) + n) << 4 | (e & 15)) ? (1 << n) : 0)
+            | byte(p, e, n + 1));
+    }
+
+    template <typename P, size_t... Is>
+    constexpr char_set(P const& p, size_sequence<Is...>)
+        : bits {byte(p, Is, 0)...}, eof(p(EOF)) {}
+
+    static constexpr uint8_t fill(size_t, uint8_t const b) {
+        return b;
+    }
+
+    template <size_t... Is>
+    constexpr char_set(uint8_t const b, bool const e, size_sequence<Is...>)
+        : bits {fill(Is, b)...}, eof(e) {}
+
+    template <size_t... Is>
+    constexpr char_set(char_set const& a, char_set const& b, size_sequence<Is...>)
+        : bits {static_cast<uint8_t>(a.bits[Is] | b.bits[Is])...}, eof(a.eof || b.eof) {}
+
+public:
+    template <typename P, typename = typename P::is_predicate_type>
+    constexpr explicit char_set(P const& p) : char_set(p, range<0, 32>()) {}
+
+    static constexpr char_set none() {
+        return char_set(0, false, range<0, 32>());
+    }
+
+    static constexpr char_set all() {
+        return char_set(0xff, true, range<0, 32>());
+    }
+
+    constexpr char_set operator| (char_set const& b) const {
+        return char_set(*this, b, range<0, 32>());
+    }
+
+    bool operator() (int const c) const {
+        if (c == EOF) {
+            return eof;
+        }
+        unsigned const u = static_cast<unsigned char>(c);
+        return ((bits[(u & 15) | ((u >> 3) & 16)] >> ((u >> 4) & 7)) & 1) != 0;
+    }
+
+    // Returns the first position in [f, l) whose symbol is not in the set.
+    // Most runs are short, so a few symbols are tested before vectorising.
+    char const* scan(char const* f, char const* l) const {
+        for (char const* const g = (l - f > 8) ? f + 8 : l; f != g; ++f) {
+            if (!(*this)(static_cast<unsigned char>(*f))) {
+                return f;
+            }
+        }
+        return scan_long(f, l);
+    }
+
+private:
+    char const* scan_long(char const* f, char const* l) const {
+#if defined(__AVX2__)
+        {
+            __m256i const lo_tab = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(bits)));
+            __m256i const hi_tab = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(bits + 16)));
+            __m256i const bit_tab = _mm256_setr_epi8(
+                1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+            __m256i const nibble = _mm256_set1_epi8(0x0f);
+            while (l - f >= 32) {
+                __m256i const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(f));
+                __m256i const lo = _mm256_and_si256(v, nibble);
+                __m256i const hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+                __m256i const row = _mm256_blendv_epi8(_mm256_shuffle_epi8(lo_tab, lo),
+                    _mm256_shuffle_epi8(hi_tab, lo), v);
+                __m256i const bit = _mm256_shuffle_epi8(bit_tab, hi);
+                uint32_t const in = static_cast<uint32_t>(_mm256_movemask_epi8(
+                    _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit)));
+                if (in != 0xffffffffu) {
+                    return f + __builtin_ctz(~in);
+                }
+                f += 32;
+            }
+        }
+#endif
+#if defined(__SSE4_1__)
+        {
+            __m128i const lo_tab = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bits));
+            __m128i const hi_tab = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bits + 16));
+            __m128i const bit_tab = _mm_setr_epi8(
+                1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+            __m128i const nibble = _mm_set1_epi8(0x0f);
+            while (l - f >= 16) {
+                __m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(f));
+                __m128i const lo = _mm_and_si128(v, nibble);
+                __m128i const hi = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+                __m128i const row = _mm_blendv_epi8(_mm_shuffle_epi8(lo_tab, lo),
+                    _mm_shuffle_epi8(hi_tab, lo), v);
+                __m128i const bit = _mm_shuffle_epi8(bit_tab, hi);
+                uint32_t const in = static_cast<uint32_t>(_mm_movemask_epi8(
+                    _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit)));
+                if (in != 0xffffu) {
+                    return f + __builtin_ctz(~in);
+                }
+                f += 16;
+            }
+        }
+#endif
+        while (f != l && (*this)(static_cast<unsigned char>(*f))) {
+            ++f;
+        }
+        return f;
+    }
+};
+
+//============================================================================
+// First Sets
+//
+// The symbols a parser can start with, and whether it can succeed without
+// consuming any. A parser that cannot start with the next symbol fails
+// without consuming input or calling any functors, so a choice can skip it
+// and go straight to an alternative that can match. Parsers that do not
+// know their first set, such as handles and references, admit everything
+// and are always tried in order.
+
+class first_set {
+    char_set const symbols;
+    bool const nullable;
+
+public:
+    constexpr first_set(char_set const& s, bool const n) : symbols(s), nullable(n) {}
+
+    static constexpr first_set unknown() {
+        return first_set(char_set::all(), true);
+    }
+
+    bool admits(int const c) const {
+        return nullable || symbols(c);
+    }
+
+    // Either parser may start.
+    constexpr first_set operator| (first_set const& b) const {
+        return first_set(symbols | b.symbols, nullable || b.nullable);
+    }
+
+    // This parser followed by the next.
+    constexpr first_set then(first_set const& b) const {
+        return nullable ? first_set(symbols | b.symbols, b.nullable) : *this;
+    }
+
+    constexpr first_set optional() const {
+        return first_set(symbols, true);
+    }
+};
+
+template <typename P>
+constexpr auto first_of(P const& p, int) -> decltype(p.first()) {
+    return p.first();
+}
+
+template <typename P>
+constexpr first_set first_of(P const&, long) {
+    return first_set::unknown();
+}
+
+template <typename P>
+constexpr first_set first_of(P const& p) {
+    return first_of(p, 0);
+}
+
+constexpr first_set first_of_sequence() {
+    return first_set(char_set::none(), true);
+}
+
+template <typename P, typename... Ps>
+constexpr first_set first_of_sequence(P const& p, Ps const&... ps) {
+    return first_of(p).then(first_of_sequence(ps...));
+}
+
+template <typename Iterator, typename Range>
+int lookahead(Iterator const &i, Range const &r) {
+    return (i == r.last) ? EOF : static_cast<unsigned char>(*i);
+}
+
+//============================================================================
+// Input Spans
+//
+// The result of a token that refers back to the input instead of copying
+// it. Only iterators that are plain character pointers are contiguous; for
+// any other iterator the symbols are copied into the span's own storage.
+
+template <typename Iterator> struct is_contiguous : false_type {};
+template <> struct is_contiguous<char const*> : true_type {};
+template <> struct is_contiguous<char*> : true_type {};
+
+class char_span {
+    string buf;
+    bool owned;
+    char const* f;
+    char const* l;
+
+    void release() {
+        buf.clear();
+        owned = false;
+        f = l = nullptr;
+    }
+
+public:
+    char_span() : owned(false), f(nullptr), l(nullptr) {}
+    char_span(char const* f, char const* l) : owned(false), f(f), l(l) {}
+    explicit char_span(string&& s) : buf(move(s)), owned(true), f(buf.data()), l(f + buf.size()) {}
+
+    char_span(char_span const& s) : buf(s.buf), owned(s.owned),
+        f(owned ? buf.data() : s.f), l(f + s.size()) {}
+
+    char_span(char_span&& s) : buf(move(s.buf)), owned(s.owned),
+        f(owned ? buf.data() : s.f), l(f + s.size()) {
+        s.release();
+    }
+
+    char_span& operator= (char_span const& s) {
+        if (this != &s) {
+            buf = s.buf;
+            owned = s.owned;
+            f = owned ? buf.data() : s.f;
+            l = f + s.size();
+        }
+        return *this;
+    }
+
+    char_span& operator= (char_span&& s) {
+        if (this != &s) {
+            size_t const n = s.size();
+            buf = move(s.buf);
+            owned = s.owned;
+            f = owned ? buf.data() : s.f;
+            l = f + n;
+            s.release();
+        }
+        return *this;
+    }
+
+    char const* begin() const {
+        return f;
+    }
+
+    char const* end() const {
+        return l;
+    }
+
+    char const* data() const {
+        return f;
+    }
+
+    size_t size() const {
+        return l - f;
+    }
+
+    bool empty() const {
+        return f == l;
+    }
+
+    char operator[] (size_t const n) const {
+        return f[n];
+    }
+
+    string str() const {
+        return string(f, l);
+    }
+
+    bool operator== (char const* s) const {
+        char const* i = f;
+        while (i != l && *s != 0 && *i == *s) {
+            ++i;
+            ++s;
+        }
+        return i == l && *s == 0;
+    }
+
+    bool operator!= (char const* s) const {
+        return !(*this == s);
+    }
+
+    bool operator== (string const& s) const {
+        return s.compare(0, string::npos, f, size()) == 0;
+    }
+
+    bool operator!= (string const& s) const {
+        return !(*this == s);
+    }
+
+    friend ostream& operator<< (ostream& out, char_span const& s) {
+        return out.write(s.f, s.size());
+    }
+};
+
 //============================================================================
 // Primitive String Recognisers: accept, accept_str
 
 //----------------------------------------------------------------------------
 // Stream is advanced if symbol matches, and symbol is appended to result.
+// The result is a string, or another basic_string such as arena_string when
+// given as accept<String>(p).
 
-template <typename Predicate> class recogniser_accept {
+template <typename Predicate, typename String = string> class recogniser_accept {
     Predicate const p;
+    char_set const s;
 
 public:
     using is_parser_type = true_type;
     using is_handle_type = false_type;
     using has_side_effects = false_type;
-    using result_type = string;
+    using result_type = String;
     int const rank;
 
-    constexpr explicit recogniser_accept(Predicate const& p) : p(p), rank(p.rank) {}
+    constexpr explicit recogniser_accept(Predicate const& p) : p(p), s(p), rank(p.rank) {}
 
     template <typename Iterator, typename Range, typename Inherit = default_inherited>
     bool operator() (
         Iterator &i,
         Range const &r,
-        string *result = nullptr,
+        String *result = nullptr,
         Inherit* st = nullptr
     ) const {
         int sym;
         if (i == r.last) {
             sym = EOF;
         } else {
-            sym = *i;
+            sym = static_cast<unsigned char>(*i);
         }
-        if (!p(sym)) {
+        if (!s(sym)) {
             return false;
         }
         ++i;
@@ -485,36 +1247,45 @@ public:
         return true;
     }
 
+    constexpr first_set first() const {
+        return first_set(s, false);
+    }
+
+    char const* scan(char const* f, char const* l) const {
+        return s.scan(f, l);
+    }
+
     string ebnf(unique_defs* defs = nullptr) const {
         return p.name();
     }
 };
 
-template <typename P, typename = typename P::is_predicate_type>
-constexpr recogniser_accept<P> accept(P const &p) {
-    return recogniser_accept<P>(p);
+template <typename String = string, typename P, typename = typename P::is_predicate_type>
+constexpr recogniser_accept<P, String> accept(P const &p) {
+    return recogniser_accept<P, String>(p);
 }
 
 //-----------------------------------------------------------------------------
-// String Parser.
+// String Parser. accept_str results are strings; basic_accept_str<String>
+// appends to another basic_string, such as arena_string.
 
-class accept_str {
+template <typename String> class basic_accept_str {
     char const* s;
 
 public:
     using is_parser_type = true_type;
     using is_handle_type = false_type;
     using has_side_effects = false_type;
-    using result_type = string;
+    using result_type = String;
     int const rank = 0;
 
-    constexpr explicit accept_str(char const* s) : s(s) {}
+    constexpr explicit basic_accept_str(char const* s) : s(s) {}
 
     template <typename Iterator, typename Range, typename Inherit = default_inherited>
     bool operator() (
         Iterator &i,
         Range const &r,
-        string *result = nullptr,
+        String *result = nullptr,
         Inherit* st = nullptr
     ) const {
         for (auto j = s; *j != 0;  ++j) {
@@ -529,11 +1300,294 @@ public:
         return true;
     }
 
-    string ebnf(unique_defs* defs = nullptr) const {
+    constexpr first_set first() const {
+        return (*s == 0) ? first_set(char_set::none(), true)
+            : first_set(char_set(is_char(*s)), false);
+    }
+
+    string ebnf(unique_defs* defs = nullptr) const {
         return "\"" + string(s) + "\"";
     }
 };
 
+using accept_str = basic_accept_str<string>;
+
+//============================================================================
+// Primitive Number Parsers: accept_int, accept_float
+//
+// Numbers are converted as they are scanned, instead of being collected into
+// a string and converted afterwards. A value that does not fit the result
+// type is a parse_error rather than a failure, as the input was a number,
+// whether or not the result is kept. A parser that fails, like "-x", "0x" or
+// "1e", leaves the iterator where it started.
+
+constexpr unsigned digit_value(int const c) {
+    return (c >= '0' && c <= '9') ? c - '0'
+        : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+        : (c >= 'A' && c <= 'F') ? c - 'A' + 10
+        : 99;
+}
+
+//----------------------------------------------------------------------------
+// Integers: optional sign (for signed types), then decimal digits, or "0x"
+// followed by hexadecimal digits.
+
+template <typename T> class recogniser_int {
+    static_assert(is_integral<T>::value, "accept_int requires an integral type");
+    using unsigned_type = typename make_unsigned<T>::type;
+
+public:
+    using is_parser_type = true_type;
+    using is_handle_type = false_type;
+    using has_side_effects = false_type;
+    using result_type = T;
+    int const rank = 0;
+
+    constexpr recogniser_int() {}
+
+    template <typename Iterator, typename Range, typename Inherit = default_inherited>
+    bool operator() (
+        Iterator &i,
+        Range const &r,
+        result_type *result = nullptr,
+        Inherit* st = nullptr
+    ) const {
+        Iterator const first = i;
+        backtrack_window::frame const window(first - r.first);
+        bool neg = false;
+        if (is_signed<T>::value && i != r.last && (*i == '-' || *i == '+')) {
+            neg = (*i == '-');
+            ++i;
+        }
+        if (i == r.last || digit_value(*i) >= 10) {
+            i = first;
+            return false;
+        }
+
+        unsigned base = 10;
+        if (*i == '0') {
+            ++i;
+            if (i != r.last && (*i == 'x' || *i == 'X')) {
+                ++i;
+                if (i == r.last || digit_value(*i) >= 16) {
+                    i = first;
+                    return false;
+                }
+                base = 16;
+            }
+        }
+
+        unsigned_type const limit = neg
+            ? static_cast<unsigned_type>(numeric_limits<T>::max()) + 1
+            : static_cast<unsigned_type>(numeric_limits<T>::max());
+        unsigned_type const cutoff = (base == 10) ? limit / 10 : limit / 16;
+        unsigned const cutlim = (base == 10) ? limit % 10 : limit % 16;
+        unsigned_type v = 0;
+        bool overflow = false;
+        for (; i != r.last; ++i) {
+            unsigned const d = digit_value(*i);
+            if (d >= base) {
+                break;
+            }
+            if (v > cutoff || (v == cutoff && d > cutlim)) {
+                overflow = true;
+            } else {
+                v = v * base + d;
+            }
+        }
+
+        if (overflow) {
+            throw parse_error("integer overflow", *this, first, i, r);
+        }
+        if (result != nullptr) {
+            *result = static_cast<T>(neg ? ~v + 1 : v);
+        }
+        return true;
+    }
+
+    constexpr first_set first() const {
+        return first_set(is_signed<T>::value
+            ? char_set(is_digit || is_char('-') || is_char('+'))
+            : char_set(is_digit), false);
+    }
+
+    string ebnf(unique_defs* defs = nullptr) const {
+        return "integer";
+    }
+};
+
+template <typename T> constexpr recogniser_int<T> accept_int() {
+    return recogniser_int<T>();
+}
+
+//----------------------------------------------------------------------------
+// Floating point: optional sign, digits with an optional fraction (at least
+// one digit in all), and an optional exponent. When the significant digits
+// fit the mantissa and the power of ten is exact, a single multiply or divide
+// is correctly rounded (Clinger's fast path). Otherwise the digits that were
+// collected are converted by the C library, which rounds correctly.
+
+template <typename T> struct float_traits {};
+
+template <> struct float_traits<double> {
+    static constexpr uint64_t max_mantissa = uint64_t(1) << 53;
+    static constexpr int max_exact_pow10 = 22;
+    static double pow10(int const e) {
+        static double const p[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        return p[e];
+    }
+    static double convert(char const* s) {
+        return strtod(s, nullptr);
+    }
+};
+
+template <> struct float_traits<float> {
+    static constexpr uint64_t max_mantissa = uint64_t(1) << 24;
+    static constexpr int max_exact_pow10 = 10;
+    static float pow10(int const e) {
+        static float const p[] = {
+            1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+        };
+        return p[e];
+    }
+    static float convert(char const* s) {
+        return strtof(s, nullptr);
+    }
+};
+
+template <typename T> class recogniser_float {
+    using traits = float_traits<T>;
+
+    // More significant digits than this cannot change a correctly rounded
+    // double; further digits only matter in being non-zero.
+    static constexpr int max_digits = 780;
+
+public:
+    using is_parser_type = true_type;
+    using is_handle_type = false_type;
+    using has_side_effects = false_type;
+    using result_type = T;
+    int const rank = 0;
+
+    constexpr recogniser_float() {}
+
+    template <typename Iterator, typename Range, typename Inherit = default_inherited>
+    bool operator() (
+        Iterator &i,
+        Range const &r,
+        result_type *result = nullptr,
+        Inherit* st = nullptr
+    ) const {
+        Iterator const first = i;
+        backtrack_window::frame const window(first - r.first);
+        bool neg = false;
+        if (i != r.last && (*i == '-' || *i == '+')) {
+            neg = (*i == '-');
+            ++i;
+        }
+
+        char digits[max_digits + 1];
+        int nd = 0;         // significant digits collected
+        int exp10 = 0;      // value = digits * 10^exp10
+        bool seen = false;  // any mantissa digit at all
+        bool sticky = false;
+        uint64_t w = 0;
+
+        for (; i != r.last && digit_value(*i) < 10; ++i) {
+            seen = true;
+            if (nd == 0 && *i == '0') {
+                continue;
+            }
+            if (nd < max_digits) {
+                digits[nd++] = static_cast<char>(*i);
+                w = (nd <= 19) ? w * 10 + (*i - '0') : w;
+            } else {
+                sticky |= (*i != '0');
+                ++exp10;
+            }
+        }
+        if (i != r.last && *i == '.') {
+            ++i;
+            for (; i != r.last && digit_value(*i) < 10; ++i) {
+                seen = true;
+                if (nd == 0 && *i == '0') {
+                    --exp10;
+                } else if (nd < max_digits) {
+                    digits[nd++] = static_cast<char>(*i);
+                    w = (nd <= 19) ? w * 10 + (*i - '0') : w;
+                    --exp10;
+                } else {
+                    sticky |= (*i != '0');
+                }
+            }
+        }
+        if (!seen) {
+            i = first;
+            return false;
+        }
+
+        if (i != r.last && (*i == 'e' || *i == 'E')) {
+            ++i;
+            bool eneg = false;
+            if (i != r.last && (*i == '-' || *i == '+')) {
+                eneg = (*i == '-');
+                ++i;
+            }
+            if (i == r.last || digit_value(*i) >= 10) {
+                i = first;
+                return false;
+            }
+            int e = 0;
+            for (; i != r.last && digit_value(*i) < 10; ++i) {
+                if (e < 100000) {
+                    e = e * 10 + (*i - '0');
+                }
+            }
+            exp10 += eneg ? -e : e;
+        }
+
+        T v;
+        if (nd == 0) {
+            v = 0;
+        } else if (nd <= 19 && !sticky && w <= traits::max_mantissa
+            && exp10 >= -traits::max_exact_pow10 && exp10 <= traits::max_exact_pow10) {
+            v = (exp10 < 0) ? static_cast<T>(w) / traits::pow10(-exp10)
+                : static_cast<T>(w) * traits::pow10(exp10);
+        } else {
+            if (sticky) {
+                digits[nd++] = '1';
+                --exp10;
+            }
+            string s(digits, nd);
+            s += 'e';
+            s += to_string(exp10);
+            v = traits::convert(s.c_str());
+            if (v == numeric_limits<T>::infinity()) {
+                throw parse_error("floating point overflow", *this, first, i, r);
+            }
+        }
+        if (result != nullptr) {
+            *result = neg ? -v : v;
+        }
+        return true;
+    }
+
+    constexpr first_set first() const {
+        return first_set(char_set(is_digit || is_char('.') || is_char('-') || is_char('+')), false);
+    }
+
+    string ebnf(unique_defs* defs = nullptr) const {
+        return "number";
+    }
+};
+
+template <typename T> constexpr recogniser_float<T> accept_float() {
+    return recogniser_float<T>();
+}
+
 //============================================================================
 // Constant Parsers: succ, fail
 
@@ -559,6 +1613,10 @@ struct parser_succ {
         return true;
     }
 
+    constexpr first_set first() const {
+        return first_set(char_set::none(), true);
+    }
+
     string ebnf(unique_defs* defs = nullptr) const {
         return "succ";
     }
@@ -586,6 +1644,10 @@ struct parser_fail {
         return false;
     }
 
+    constexpr first_set first() const {
+        return first_set(char_set::none(), false);
+    }
+
     string ebnf(unique_defs* defs = nullptr) const {
         return "fail";
     }
@@ -639,23 +1701,28 @@ public:
 private:
     tuple_type const ps;
     Functor const f;
+    first_set const fs[sizeof...(Parsers)];
 
     template <typename Iterator, typename Range, typename Inherit, typename Rs, size_t I0, size_t... Is> 
-    int any_parsers(Iterator &i, Range const &r, Inherit* st, Rs &rs, size_t, size_t...) const {
-        if (get<I0>(ps)(i, r, &get<I0>(rs), st)) {
+    int any_parsers(Iterator &i, Range const &r, int sym, Inherit* st, Rs &rs, size_t, size_t...) const {
+        if (fs[I0].admits(sym) && get<I0>(ps)(i, r, &get<I0>(rs), st)) {
             return I0;
         }
-        return any_parsers<Iterator, Range, Inherit, Rs, Is...>(i, r, st, rs, Is...);
+        return any_parsers<Iterator, Range, Inherit, Rs, Is...>(i, r, sym, st, rs, Is...);
     }
 
     template <typename Iterator, typename Range, typename Inherit, typename Rs, size_t I0>
-    int any_parsers(Iterator &i, Range const &r, Inherit* st, Rs &rs, size_t) const {
-        if (get<I0>(ps)(i, r, &get<I0>(rs), st)) {
+    int any_parsers(Iterator &i, Range const &r, int sym, Inherit* st, Rs &rs, size_t) const {
+        if (fs[I0].admits(sym) && get<I0>(ps)(i, r, &get<I0>(rs), st)) {
             return I0;
         }
         return -1;
     }
 
+    constexpr first_set first_of_any(size_t const n) const {
+        return (n == 0) ? first_set(char_set::none(), false) : fs[n - 1] | first_of_any(n - 1);
+    }
+
     template <typename Iterator, typename Range, typename Inherit, size_t... I> bool fmap_any(
         Iterator &i,
         Range const &r,
@@ -665,7 +1732,7 @@ private:
     ) const {
         tmp_type tmp {};
         Iterator const first = i;
-        int const j = any_parsers<Iterator, Range, Inherit, tmp_type, I...>(i, r, st, tmp, I...);
+        int const j = any_parsers<Iterator, Range, Inherit, tmp_type, I...>(i, r, lookahead(i, r), st, tmp, I...);
         if (j >= 0) {
             if (result != nullptr) {
                 call_any<Functor, Inherit> call_f(f);
@@ -684,7 +1751,7 @@ public:
     int const rank = 1;
 
     constexpr explicit fmap_choice(Functor const& f, Parsers const&... ps)
-        : f(f), ps(ps...) {}
+        : ps(ps...), f(f), fs {first_of(ps)...} {}
 
     template <typename Iterator, typename Range, typename Inherit>
     bool operator() (
@@ -696,6 +1763,10 @@ public:
         return fmap_any(i, r, range<0, sizeof...(Parsers)>(), result, st);
     }
 
+    constexpr first_set first() const {
+        return first_of_any(sizeof...(Parsers));
+    }
+
     class choice_ebnf {
         int const rank;
         unique_defs* defs;
@@ -766,6 +1837,7 @@ public:
 private:
     tuple_type const ps;
     Functor const f;
+    first_set const fs;
 
     template <typename Iterator, typename Range, typename Inherit, typename Rs, size_t I0, size_t... Is> 
     bool all_parsers(Iterator &i, Range const &r, Inherit* st, Rs &rs, size_t, size_t...) const {
@@ -802,7 +1874,7 @@ public:
     int const rank = 0;
 
     constexpr fmap_sequence(Functor const& f, Parsers const&... ps)
-        : f(f), ps(ps...) {}
+        : ps(ps...), f(f), fs(first_of_sequence(ps...)) {}
 
     template <typename Iterator, typename Range, typename Inherit = default_inherited>
     bool operator() (
@@ -814,6 +1886,10 @@ public:
         return fmap_all(i, r, range<0, sizeof...(Parsers)>(), result, st);
     }
 
+    constexpr first_set first() const {
+        return fs;
+    }
+
     class sequence_ebnf {
         int const rank;
         unique_defs* defs;
@@ -852,6 +1928,8 @@ constexpr fmap_sequence<F, PS...> const all(F const& f, PS const&... ps) {
 template <typename Parser1, typename Parser2> class combinator_choice { 
     Parser1 const p1;
     Parser2 const p2;
+    first_set const f1;
+    first_set const f2;
 
 public:
     using is_parser_type = true_type;
@@ -861,7 +1939,8 @@ public:
     using result_type = typename least_general<Parser1, Parser2>::result_type;
     int const rank = 1;
 
-    constexpr combinator_choice(Parser1 const& p1, Parser2 const& p2) : p1(p1), p2(p2) {}
+    constexpr combinator_choice(Parser1 const& p1, Parser2 const& p2)
+        : p1(p1), p2(p2), f1(first_of(p1)), f2(first_of(p2)) {}
 
     template <typename Iterator, typename Range, typename Inherit = default_inherited>
     bool operator() (
@@ -870,17 +1949,19 @@ public:
         result_type *result = nullptr,
         Inherit* st = nullptr
     ) const {
+        int const sym = lookahead(i, r);
         Iterator const first = i;
-        if (p1(i, r, result, st)) {
+        if (f1.admits(sym) && p1(i, r, result, st)) {
             return true;
         }
         if (first != i) {
             throw parse_error("failed parser consumed input", p1, first, i, r);
         }
-        if (p2(i, r, result, st)) {
-            return true;
-        }
-        return false;
+        return f2.admits(sym) && p2(i, r, result, st);
+    }
+
+    constexpr first_set first() const {
+        return f1 | f2;
     }
 
     string ebnf(unique_defs* defs = nullptr) const {
@@ -925,6 +2006,10 @@ public:
         return p1(i, r, result, st) && p2(i, r, result, st);
     }
 
+    constexpr first_set first() const {
+        return first_of(p1).then(first_of(p2));
+    }
+
     string ebnf(unique_defs* defs = nullptr) const {
         return format_name(p1, rank, defs) + ", " + format_name(p2, rank, defs);
     }
@@ -941,11 +2026,33 @@ constexpr combinator_sequence<P1, P2> operator&& (P1 const& p1, P2 const& p2) {
 }
 
 //----------------------------------------------------------------------------
-// Accept the parser zero or more times.
+// Accept the parser zero or more times. Repeating a single character
+// recogniser over contiguous input scans the whole run at once.
+
+template <typename Parser, typename Iterator> struct is_span_scannable : false_type {};
+template <typename P, typename S, typename Iterator>
+struct is_span_scannable<recogniser_accept<P, S>, Iterator> : is_contiguous<Iterator> {};
 
 template <typename Parser> class combinator_many {
     Parser const p;
 
+    // Returns true if the run is known to be complete, the symbol at 'i'
+    // having been rejected; at the end of input EOF still has to be tested.
+    template <typename Iterator, typename Range, typename Result>
+    bool scan(Iterator &i, Range const &r, Result *result, false_type) const {
+        return false;
+    }
+
+    template <typename Iterator, typename Range, typename Result>
+    bool scan(Iterator &i, Range const &r, Result *result, true_type) const {
+        Iterator const first = i;
+        i = p.scan(i, r.last);
+        if (result != nullptr && i != first) {
+            result->append(first, i - first);
+        }
+        return i != r.last;
+    }
+
 public:
     using is_parser_type = true_type;
     using is_handle_type = false_type;
@@ -962,6 +2069,9 @@ public:
         result_type *result = nullptr,
         Inherit* st = nullptr
     ) const {
+        if (scan(i, r, result, is_span_scannable<Parser, Iterator>())) {
+            return true;
+        }
         Iterator first = i;
         while (p(i, r, result, st)) {
             first = i;
@@ -972,6 +2082,10 @@ public:
         return true;
     }
 
+    constexpr first_set first() const {
+        return first_of(p).optional();
+    }
+
     string ebnf(unique_defs* defs = nullptr) const {
         return "{" + p.ebnf(defs) + "}";
     }
@@ -984,7 +2098,7 @@ constexpr combinator_many<P> const many(P const& p) {
 }
 
 //----------------------------------------------------------------------------
-// Exception parser
+// Exception parser: fails if the parser's result is the excluded string.
 
 template <typename Parser> class combinator_except {
     Parser const p;
@@ -1008,9 +2122,9 @@ public:
     ) const {
         result_type tmp;
         if (p(i, r, &tmp, st)) {
-            if (x != tmp) {
+            if (tmp != x) {
                 if (result != nullptr) {
-                    *result = tmp;
+                    *result = move(tmp);
                 }
                 return true;
             }
@@ -1018,6 +2132,10 @@ public:
         return false;
     }
 
+    constexpr first_set first() const {
+        return first_of(p);
+    }
+
     string ebnf(unique_defs* defs = nullptr) const {
         return p.ebnf(defs) + " - \"" + x + "\"";
     }
@@ -1154,7 +2272,10 @@ public:
 
     template <typename Iterator, typename Range, typename Inherit = default_inherited>
     bool operator() (Iterator &i, Range const &r, result_type *result = nullptr, Inherit* st = nullptr) const {
-        return (*p)(i, r, result, st);
+        rule_scope scope(name, i - r.first);
+        bool const b = (*p)(i, r, result, st);
+        scope.done(b, i - r.first);
+        return b;
     }
 
     string ebnf(unique_defs* defs = nullptr) const {
@@ -1176,10 +2297,11 @@ constexpr parser_ref<P> reference(char const* name, P const* p) {
 }
 
 //----------------------------------------------------------------------------
-// Fixed Point Parser, neater way to define simple recursive parsers.
+// Fixed Point Parser, neater way to define simple recursive parsers. The body
+// is the parser returned by 'F' unless wrapped, see memo_fix.
 
-template <typename F> class parser_fix {
-    using parser_type = typename function_traits<F>::return_type;
+template <typename F, typename Body = typename function_traits<F>::return_type> class parser_fix {
+    using parser_type = Body;
     parser_type const p;
 
 public:
@@ -1194,7 +2316,24 @@ public:
 
     template <typename Iterator, typename Range, typename Inherit = default_inherited>
     bool operator() (Iterator &i, Range const &r, result_type *result = nullptr, Inherit* st = nullptr) const {
-        return p(i, r, result, st);
+        rule_scope scope(name, i - r.first);
+        bool const b = p(i, r, result, st);
+        scope.done(b, i - r.first);
+        return b;
+    }
+
+    constexpr first_set first() const {
+        return first_of(p);
+    }
+
+    template <typename P = parser_type>
+    auto stats() const -> decltype(declval<P const&>().stats()) {
+        return p.stats();
+    }
+
+    template <typename P = parser_type>
+    auto reset() const -> decltype(declval<P const&>().reset()) {
+        return p.reset();
     }
 
     string ebnf(unique_defs* defs = nullptr) const {
@@ -1241,6 +2380,10 @@ public:
         return p(i, r, discard_result, st);
     }
 
+    constexpr first_set first() const {
+        return first_of(p);
+    }
+
     string ebnf(unique_defs* defs = nullptr) const {
         return p.ebnf(defs);
     }
@@ -1252,6 +2395,81 @@ constexpr combinator_discard<P> const discard(P const& p) {
     return combinator_discard<P>(p);
 }
 
+//----------------------------------------------------------------------------
+// Replace the result of the parser with the span of input it matched,
+// including anything the parser discards, whatever the iterator. Over
+// contiguous input this never copies the symbols; over other input the
+// matched input is read again into storage owned by the span.
+
+template <typename Parser> class combinator_span {
+    Parser const p;
+
+    template <typename Iterator, typename Range, typename Inherit>
+    bool parse(Iterator &i, Range const &r, char_span *result, Inherit* st, true_type) const {
+        Iterator const first = i;
+        typename Parser::result_type *const discard_result = nullptr;
+        if (!p(i, r, discard_result, st)) {
+            return false;
+        }
+        if (result != nullptr) {
+            *result = char_span(first, i);
+        }
+        return true;
+    }
+
+    template <typename Iterator, typename Range, typename Inherit>
+    bool parse(Iterator &i, Range const &r, char_span *result, Inherit* st, false_type) const {
+        Iterator const first = i;
+        backtrack_window::frame const window(first - r.first);
+        typename Parser::result_type *const discard_result = nullptr;
+        if (!p(i, r, discard_result, st)) {
+            return false;
+        }
+        if (result != nullptr) {
+            string s;
+            for (Iterator j = first; j != i; ++j) {
+                s.push_back(*j);
+            }
+            *result = char_span(move(s));
+        }
+        return true;
+    }
+
+public:
+    using is_parser_type = true_type;
+    using is_handle_type = false_type;
+    using has_side_effects = typename Parser::has_side_effects;
+    using result_type = char_span;
+    int const rank;
+
+    constexpr explicit combinator_span(Parser const& q)
+        : p(q), rank(q.rank) {}
+
+    template <typename Iterator, typename Range, typename Inherit = default_inherited>
+    bool operator() (
+        Iterator &i,
+        Range const &r,
+        result_type *result = nullptr,
+        Inherit* st = nullptr
+    ) const {
+        return parse(i, r, result, st, is_contiguous<Iterator>());
+    }
+
+    constexpr first_set first() const {
+        return first_of(p);
+    }
+
+    string ebnf(unique_defs* defs = nullptr) const {
+        return p.ebnf(defs);
+    }
+};
+
+template <typename P, typename = typename enable_if<is_same<typename P::is_parser_type, true_type>::value
+    || is_same<typename P::is_handle_type, true_type>::value>::type>
+constexpr combinator_span<P> const span(P const& p) {
+    return combinator_span<P>(p);
+}
+
 //----------------------------------------------------------------------------
 // Logging Parser
 
@@ -1277,7 +2495,9 @@ public:
         result_type *result = nullptr,
         Inherit* st = nullptr
     ) const {
+#ifdef DEBUG
         Iterator const x = i;
+#endif
 
         bool const b = p(i, r, result, st);
 
@@ -1296,6 +2516,10 @@ public:
         return b;
     }
 
+    constexpr first_set first() const {
+        return first_of(p);
+    }
+
     string ebnf(unique_defs* defs = nullptr) const {
         return p.ebnf(defs);
     }
@@ -1331,6 +2555,7 @@ public:
         Inherit* st = nullptr
     ) const {
         Iterator const first = i;
+        backtrack_window::frame const window(first - r.first);
         if (p(i, r, result, st)) {
             return true;
         } 
@@ -1338,6 +2563,10 @@ public:
         return false;
     }
 
+    constexpr first_set first() const {
+        return first_of(p);
+    }
+
     string ebnf(unique_defs* defs = nullptr) const {
         return p.ebnf(defs);
     }
@@ -1364,6 +2593,7 @@ public:
         Inherit* st = nullptr
     ) const {
         Iterator const first = i;
+        backtrack_window::frame const window(first - r.first);
         Inherit inh;
         if (st != nullptr) {
             inh = *st;
@@ -1378,6 +2608,10 @@ public:
         return false;
     }
 
+    constexpr first_set first() const {
+        return first_of(p);
+    }
+
     string ebnf(unique_defs* defs = nullptr) const {
         return p.ebnf(defs);
     }
@@ -1434,6 +2668,11 @@ public:
         return true;
     }
 
+    // A strict parser never fails, so it must always be tried.
+    constexpr first_set first() const {
+        return first_set::unknown();
+    }
+
     string ebnf(unique_defs* defs = nullptr) const {
         return p.ebnf(defs);
     }
@@ -1473,6 +2712,10 @@ public:
         return p(i, r, result, st);
     }
 
+    constexpr first_set first() const {
+        return first_of(p);
+    }
+
     string ebnf(unique_defs* defs = nullptr) const {
         return n(defs);
     }
@@ -1509,9 +2752,16 @@ public:
         result_type *result = nullptr,
         Inherit* st = nullptr
     ) const {
-        return p(i, r, result, st);
+        rule_scope scope(name, i - r.first);
+        bool const b = p(i, r, result, st);
+        scope.done(b, i - r.first);
+        return b;
     }
     
+    constexpr first_set first() const {
+        return first_of(p);
+    }
+
     string ebnf(unique_defs* defs = nullptr) const {
         string const n = p.ebnf(defs);
         if (defs != nullptr) {
@@ -1527,6 +2777,619 @@ constexpr parser_def<P> define(char const* s, P const& p) {
     return parser_def<P>(s, p);
 }
 
+//============================================================================
+// Packrat Memoization
+
+//----------------------------------------------------------------------------
+// Memo Statistics: counters for one memoized parser.
+
+struct memo_stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t entries;
+    size_t peak;
+
+    friend ostream& operator<< (ostream& out, memo_stats const& s) {
+        return out << "hits: " << s.hits << " misses: " << s.misses << " evictions: " << s.evictions
+            << " entries: " << s.entries << " peak: " << s.peak;
+    }
+};
+
+//----------------------------------------------------------------------------
+// Memo Table: the outcome of a parser at each position, keyed by offset from
+// the start of the range. Entries below the low mark of the backtrack window
+// can never be looked up again and are evicted. The low mark only moves
+// forward during a parse, so a lower mark, or a different range or length,
+// means a new parse has started and the table is cleared; re-using the same
+// range object for new input of the same length needs an explicit reset. When
+// a parse succeeds every entry strictly inside it is dropped, as re-parsing
+// that span will hit the outer entry first. Beyond capacity the lowest entries
+// are evicted.
+//
+// A memoized parser is run into a fresh result, which is cached, and then
+// merged into the caller's result, on a miss and on every hit alike. Strings
+// and vectors are appended to, as recognisers and functors such as push_back
+// accumulate into them under many and sep_by; other results are assigned, so
+// a memoized parser must not depend on the value already in its result.
+
+template <typename T> struct memo_value {
+    T value;
+
+    T* ptr() {
+        return &value;
+    }
+
+    void put(T* result) const {
+        *result = value;
+    }
+};
+
+// Recognisers append to string results, so a cached string is appended too.
+template <> inline void memo_value<string>::put(string* result) const {
+    result->append(value);
+}
+
+template <typename T, typename A> struct memo_value<vector<T, A>> {
+    vector<T, A> value;
+
+    vector<T, A>* ptr() {
+        return &value;
+    }
+
+    void put(vector<T, A>* result) const {
+        result->insert(result->end(), value.begin(), value.end());
+    }
+};
+
+template <> struct memo_value<void> {
+    void* ptr() {
+        return nullptr;
+    }
+
+    void put(void*) const {}
+};
+
+template <typename Iterator, typename Range, typename Result>
+class memo_table {
+    struct entry {
+        Iterator last;
+        bool success;
+        bool has_value;
+        memo_value<Result> value;
+    };
+
+    using entry_map = map<ptrdiff_t, entry>;
+
+    entry_map entries;
+    Range const* range;
+    ptrdiff_t size;
+    ptrdiff_t mark;
+    size_t const capacity;
+
+    void erase(typename entry_map::iterator const first, typename entry_map::iterator const last) {
+        stats.evictions += distance(first, last);
+        entries.erase(first, last);
+    }
+
+    memo_stats& stats;
+
+public:
+    memo_table(size_t const n, memo_stats& s) : range(nullptr), size(0), mark(0), capacity(n), stats(s) {}
+
+    void evict(Range const& r, ptrdiff_t const low) {
+        ptrdiff_t const n = r.last - r.first;
+        if (&r != range || n != size || low < mark) {
+            erase(entries.begin(), entries.end());
+            range = &r;
+            size = n;
+        } else if (low > mark) {
+            erase(entries.begin(), entries.lower_bound(low));
+        }
+        mark = low;
+        stats.entries = entries.size();
+    }
+
+    // Returns true on a hit, leaving 'i' at the end of the cached parse.
+    bool find(ptrdiff_t const pos, Iterator &i, Result* result, bool &success) {
+        auto const e = entries.find(pos);
+        if (e == entries.end() || (result != nullptr && !e->second.has_value)) {
+            ++stats.misses;
+            return false;
+        }
+        ++stats.hits;
+        i = e->second.last;
+        success = e->second.success;
+        if (success && result != nullptr) {
+            e->second.value.put(result);
+        }
+        return true;
+    }
+
+    void insert(ptrdiff_t const pos, Iterator const& i, ptrdiff_t const end, bool const success,
+        bool const has_value, memo_value<Result>&& value
+    ) {
+        if (success && end > pos + 1) {
+            erase(entries.upper_bound(pos), entries.lower_bound(end));
+        }
+        auto const e = entries.find(pos);
+        if (e != entries.end()) {
+            e->second = entry {i, success, has_value, move(value)};
+        } else {
+            entries.emplace(pos, entry {i, success, has_value, move(value)});
+        }
+        if (entries.size() > capacity) {
+            erase(entries.begin(), next(entries.begin()));
+        }
+        stats.entries = entries.size();
+        if (stats.entries > stats.peak) {
+            stats.peak = stats.entries;
+        }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Memo Store: type-erased owner of the table, as the iterator and range types
+// are only known when the parser is called.
+
+class memo_store {
+    struct table_base {
+        virtual ~table_base() {}
+    };
+
+    template <typename Table> struct holder : public table_base {
+        Table table;
+        holder(size_t const n, memo_stats& s) : table(n, s) {}
+    };
+
+    unique_ptr<table_base> table;
+    void const* kind;
+    size_t const capacity;
+
+    template <typename Table> static void const* kind_of() {
+        static char const k = 0;
+        return &k;
+    }
+
+public:
+    memo_stats stats;
+
+    explicit memo_store(size_t const n) : kind(nullptr), capacity(n), stats {0, 0, 0, 0, 0} {}
+
+    // A parser used over more than one iterator type keeps only the last table.
+    template <typename Table> Table& get() {
+        if (kind != kind_of<Table>()) {
+            table.reset(new holder<Table>(capacity, stats));
+            kind = kind_of<Table>();
+        }
+        return static_cast<holder<Table>*>(table.get())->table;
+    }
+
+    void reset() {
+        table.reset();
+        kind = nullptr;
+        stats.entries = 0;
+    }
+};
+
+//----------------------------------------------------------------------------
+// Memoizing Parser: caches success or failure, the end position, and the
+// synthesized result of 'p' at each position, so backtracking over the same
+// input re-uses the earlier parse. The parser must not depend on inherited
+// attributes. Copies share one table; it is not safe to use a memoized parser
+// from more than one thread at once.
+
+template <typename Parser>
+class parser_memo {
+    Parser const p;
+    shared_ptr<memo_store> const store;
+
+public:
+    using is_parser_type = true_type;
+    using is_handle_type = false_type;
+    using has_side_effects = typename Parser::has_side_effects;
+    using result_type = typename Parser::result_type;
+    int const rank;
+
+    static size_t const default_capacity = 1 << 16;
+
+    explicit parser_memo(Parser const& q, size_t const capacity = default_capacity)
+        : p(q), store(make_shared<memo_store>(capacity)), rank(q.rank) {}
+
+    template <typename Iterator, typename Range, typename Inherit = default_inherited>
+    bool operator() (
+        Iterator &i,
+        Range const &r,
+        result_type *result = nullptr,
+        Inherit* st = nullptr
+    ) const {
+        static_assert(is_same<Inherit, default_inherited>::value,
+            "a memoized parser cannot depend on inherited attributes");
+        using table_type = memo_table<Iterator, Range, result_type>;
+        table_type& t = store->template get<table_type>();
+        ptrdiff_t const pos = i - r.first;
+        t.evict(r, backtrack_window::current().low_mark(pos));
+
+        bool success;
+        if (t.find(pos, i, result, success)) {
+            return success;
+        }
+
+        memo_value<result_type> value;
+        success = p(i, r, (result == nullptr) ? nullptr : value.ptr(), st);
+        if (success && result != nullptr) {
+            value.put(result);
+        }
+        t.insert(pos, i, i - r.first, success, result != nullptr, move(value));
+        return success;
+    }
+
+    memo_stats stats() const {
+        return store->stats;
+    }
+
+    // Forget all cached outcomes (the counters are kept), needed before parsing
+    // new input through the same range object.
+    void reset() const {
+        store->reset();
+    }
+
+    constexpr first_set first() const {
+        return first_of(p);
+    }
+
+    string ebnf(unique_defs* defs = nullptr) const {
+        return p.ebnf(defs);
+    }
+};
+
+template <typename P, typename = typename enable_if<is_same<typename P::is_parser_type, true_type>::value
+    || is_same<typename P::is_handle_type, true_type>::value>::type>
+parser_memo<P> memo(P const& p, size_t const capacity = parser_memo<P>::default_capacity) {
+    return parser_memo<P>(p, capacity);
+}
+
+//----------------------------------------------------------------------------
+// Memoized Fixed Point: the body is memoized, so the recursive references all
+// go through the memo table.
+
+template <typename F>
+parser_fix<F, parser_memo<typename function_traits<F>::return_type>> memo_fix(char const* n, F f) {
+    return parser_fix<F, parser_memo<typename function_traits<F>::return_type>>{n, f};
+}
+
+//============================================================================
+// Operator Precedence Parser: operators
+
+//----------------------------------------------------------------------------
+// Operator table entries pair an operator token with a precedence, where higher
+// binds tighter, and a functor that builds the result from the token's result
+// and the operands: infix as f(res, left, op, right), prefix as f(res, op, x)
+// and postfix as f(res, x, op), with the inherited attribute appended when one
+// is used. A token that fails, or that matches without consuming input, is
+// rewound and is not an operator, so a nullable token cannot loop; where one
+// operator is a prefix of another list the longer one first.
+
+enum class op_fixity {infix, prefix, postfix};
+
+template <typename Functor, typename... As>
+void call_inherit(Functor const& f, default_inherited*, As&&... as) {
+    f(forward<As>(as)...);
+}
+
+template <typename Functor, typename Inherit, typename... As>
+void call_inherit(Functor const& f, Inherit* st, As&&... as) {
+    f(forward<As>(as)..., st);
+}
+
+template <typename Parser, typename Functor> class op_entry {
+protected:
+    using token_type = typename Parser::result_type;
+
+    Parser const p;
+    Functor const f;
+    first_set const fs;
+
+    template <typename Iterator, typename Range, typename Inherit>
+    bool token(Iterator &i, Range const &r, int const sym, token_type* op, Inherit* st) const {
+        if (!fs.admits(sym)) {
+            return false;
+        }
+        Iterator const first = i;
+        backtrack_window::frame const window(first - r.first);
+        if (p(i, r, op, st) && i != first) {
+            return true;
+        }
+        i = first;
+        return false;
+    }
+
+    template <typename Expression, typename Iterator, typename Range, typename Result, typename Inherit, typename... As>
+    void build(Expression const& e, Iterator const& first, Iterator const& i, Range const& r,
+        Result* result, Inherit* st, As&&... as
+    ) const {
+        Result tmp {};
+        try {
+            call_inherit(f, st, &tmp, forward<As>(as)...);
+        } catch (runtime_error &x) {
+            throw parse_error(x.what(), e, first, i, r);
+        }
+        *result = move(tmp);
+    }
+
+public:
+    int const precedence;
+
+    constexpr op_entry(int const n, Parser const& q, Functor const& g)
+        : p(q), f(g), fs(first_of(q)), precedence(n) {}
+
+    constexpr first_set first() const {
+        return fs;
+    }
+
+    string ebnf(unique_defs* defs = nullptr) const {
+        return p.ebnf(defs);
+    }
+};
+
+template <typename Parser, typename Functor> class op_infix : public op_entry<Parser, Functor> {
+    using base = op_entry<Parser, Functor>;
+    using typename base::token_type;
+    bool const right;
+
+public:
+    static constexpr op_fixity fixity = op_fixity::infix;
+
+    constexpr op_infix(bool const a, int const n, Parser const& q, Functor const& g)
+        : base(n, q, g), right(a) {}
+
+    template <typename Expression, typename Iterator, typename Range, typename Result, typename Inherit>
+    bool infix(Expression const& e, Iterator &i, Range const &r, int const sym, int const min,
+        Result* left, Inherit* st
+    ) const {
+        token_type op {};
+        Iterator const first = i;
+        if (base::precedence < min || !base::token(i, r, sym, &op, st)) {
+            return false;
+        }
+        Result x {};
+        if (!e.expression(i, r, right ? base::precedence : base::precedence + 1,
+            (left == nullptr) ? nullptr : &x, st)
+        ) {
+            throw parse_error("missing operand", e, first, i, r);
+        }
+        if (left != nullptr) {
+            base::build(e, first, i, r, left, st, *left, op, x);
+        }
+        return true;
+    }
+
+    template <typename... As> constexpr bool prefix(As&&...) const {
+        return false;
+    }
+
+    template <typename... As> constexpr bool postfix(As&&...) const {
+        return false;
+    }
+};
+
+template <typename Parser, typename Functor> class op_prefix : public op_entry<Parser, Functor> {
+    using base = op_entry<Parser, Functor>;
+    using typename base::token_type;
+
+public:
+    static constexpr op_fixity fixity = op_fixity::prefix;
+
+    constexpr op_prefix(int const n, Parser const& q, Functor const& g) : base(n, q, g) {}
+
+    template <typename... As> constexpr bool infix(As&&...) const {
+        return false;
+    }
+
+    template <typename Expression, typename Iterator, typename Range, typename Result, typename Inherit>
+    bool prefix(Expression const& e, Iterator &i, Range const &r, int const sym, Result* result, Inherit* st) const {
+        token_type op {};
+        Iterator const first = i;
+        if (!base::token(i, r, sym, &op, st)) {
+            return false;
+        }
+        Result x {};
+        if (!e.expression(i, r, base::precedence, (result == nullptr) ? nullptr : &x, st)) {
+            throw parse_error("missing operand", e, first, i, r);
+        }
+        if (result != nullptr) {
+            base::build(e, first, i, r, result, st, op, x);
+        }
+        return true;
+    }
+
+    template <typename... As> constexpr bool postfix(As&&...) const {
+        return false;
+    }
+};
+
+template <typename Parser, typename Functor> class op_postfix : public op_entry<Parser, Functor> {
+    using base = op_entry<Parser, Functor>;
+    using typename base::token_type;
+
+public:
+    static constexpr op_fixity fixity = op_fixity::postfix;
+
+    constexpr op_postfix(int const n, Parser const& q, Functor const& g) : base(n, q, g) {}
+
+    template <typename... As> constexpr bool infix(As&&...) const {
+        return false;
+    }
+
+    template <typename... As> constexpr bool prefix(As&&...) const {
+        return false;
+    }
+
+    template <typename Expression, typename Iterator, typename Range, typename Result, typename Inherit>
+    bool postfix(Expression const& e, Iterator &i, Range const &r, int const sym, int const min,
+        Result* operand, Inherit* st
+    ) const {
+        token_type op {};
+        Iterator const first = i;
+        if (base::precedence < min || !base::token(i, r, sym, &op, st)) {
+            return false;
+        }
+        if (operand != nullptr) {
+            base::build(e, first, i, r, operand, st, *operand, op);
+        }
+        return true;
+    }
+};
+
+template <typename P, typename F>
+constexpr op_infix<P, F> infix_left(int const n, P const& p, F const& f) {
+    return op_infix<P, F>(false, n, p, f);
+}
+
+template <typename P, typename F>
+constexpr op_infix<P, F> infix_right(int const n, P const& p, F const& f) {
+    return op_infix<P, F>(true, n, p, f);
+}
+
+template <typename P, typename F>
+constexpr op_prefix<P, F> prefix(int const n, P const& p, F const& f) {
+    return op_prefix<P, F>(n, p, f);
+}
+
+template <typename P, typename F>
+constexpr op_postfix<P, F> postfix(int const n, P const& p, F const& f) {
+    return op_postfix<P, F>(n, p, f);
+}
+
+//----------------------------------------------------------------------------
+// Operators Parser: parses a primary expression with prefix, infix and postfix
+// operators from the table in one left to right pass by precedence climbing.
+// Each operator is selected on the lookahead symbol, nothing but a failed
+// operator token is rewound, and an operator without an operand is an error.
+// Prefix operators are allowed before any operand, and bind the operand at
+// their own precedence.
+
+template <typename Primary, typename... Operators> class combinator_operators {
+    using tuple_type = tuple<Operators...>;
+    using end_type = integral_constant<size_t, sizeof...(Operators)>;
+
+    Primary const p;
+    tuple_type const ops;
+
+public:
+    using is_parser_type = true_type;
+    using is_handle_type = false_type;
+    using has_side_effects = true_type;
+    using result_type = typename Primary::result_type;
+    int const rank = 0;
+
+private:
+    template <typename Iterator, typename Range, typename Inherit>
+    bool prefix(Iterator&, Range const&, int, result_type*, Inherit*, end_type) const {
+        return false;
+    }
+
+    template <typename Iterator, typename Range, typename Inherit, size_t I>
+    bool prefix(Iterator &i, Range const &r, int const sym, result_type* result, Inherit* st,
+        integral_constant<size_t, I>
+    ) const {
+        return get<I>(ops).prefix(*this, i, r, sym, result, st)
+            || prefix(i, r, sym, result, st, integral_constant<size_t, I + 1>());
+    }
+
+    template <typename Iterator, typename Range, typename Inherit>
+    bool infix(Iterator&, Range const&, int, int, result_type*, Inherit*, end_type) const {
+        return false;
+    }
+
+    template <typename Iterator, typename Range, typename Inherit, size_t I>
+    bool infix(Iterator &i, Range const &r, int const sym, int const min, result_type* left, Inherit* st,
+        integral_constant<size_t, I>
+    ) const {
+        return get<I>(ops).infix(*this, i, r, sym, min, left, st)
+            || get<I>(ops).postfix(*this, i, r, sym, min, left, st)
+            || infix(i, r, sym, min, left, st, integral_constant<size_t, I + 1>());
+    }
+
+    constexpr first_set first_of_prefix(first_set const& fs, end_type) const {
+        return fs;
+    }
+
+    template <size_t I>
+    constexpr first_set first_of_prefix(first_set const& fs, integral_constant<size_t, I>) const {
+        return first_of_prefix((get<I>(ops).fixity == op_fixity::prefix) ? fs | get<I>(ops).first() : fs,
+            integral_constant<size_t, I + 1>());
+    }
+
+    class fixity_ebnf {
+        op_fixity const fixity;
+        unique_defs* defs;
+
+    public:
+        fixity_ebnf(op_fixity x, unique_defs* d) : fixity(x), defs(d) {}
+        template <typename P>
+        string operator() (string const &s, P&& p) const {
+            if (p.fixity != fixity) {
+                return s;
+            } else if (s.size() == 0) {
+                return p.ebnf(defs);
+            }
+            return s + " | " + p.ebnf(defs);
+        }
+    };
+
+    static string group(string const& s) {
+        return (s.find(" | ") == string::npos) ? s : "(" + s + ")";
+    }
+
+public:
+    constexpr explicit combinator_operators(Primary const& q, Operators const&... os) : p(q), ops(os...) {}
+
+    // Parse an operand, and the operators after it that bind at least as
+    // tightly as 'min'.
+    template <typename Iterator, typename Range, typename Inherit>
+    bool expression(Iterator &i, Range const &r, int const min, result_type *result, Inherit* st) const {
+        if (!prefix(i, r, lookahead(i, r), result, st, integral_constant<size_t, 0>()) && !p(i, r, result, st)) {
+            return false;
+        }
+        while (infix(i, r, lookahead(i, r), min, result, st, integral_constant<size_t, 0>()));
+        return true;
+    }
+
+    template <typename Iterator, typename Range, typename Inherit = default_inherited>
+    bool operator() (
+        Iterator &i,
+        Range const &r,
+        result_type *result = nullptr,
+        Inherit* st = nullptr
+    ) const {
+        return expression(i, r, numeric_limits<int>::min(), result, st);
+    }
+
+    constexpr first_set first() const {
+        return first_of_prefix(first_of(p), integral_constant<size_t, 0>());
+    }
+
+    string ebnf(unique_defs* defs = nullptr) const {
+        string const pre = fold_tuple(fixity_ebnf(op_fixity::prefix, defs), string(), ops);
+        string const in = fold_tuple(fixity_ebnf(op_fixity::infix, defs), string(), ops);
+        string const post = fold_tuple(fixity_ebnf(op_fixity::postfix, defs), string(), ops);
+        string const operand = (pre.size() == 0) ? format_name(p, rank, defs)
+            : "{" + pre + "}, " + format_name(p, rank, defs);
+        string tail = (in.size() == 0) ? string() : group(in) + ", " + operand;
+        if (post.size() != 0) {
+            tail = (tail.size() == 0) ? post : tail + " | " + post;
+        }
+        return (tail.size() == 0) ? operand : operand + ", {" + tail + "}";
+    }
+};
+
+template <typename P, typename... Os, typename = typename enable_if<is_same<typename P::is_parser_type, true_type>::value
+    || is_same<typename P::is_handle_type, true_type>::value>::type>
+constexpr combinator_operators<P, Os...> operators(P const& p, Os const&... os) {
+    return combinator_operators<P, Os...>(p, os...);
+}
+
 //============================================================================
 // Some derived definitions for convenience: option, some
 
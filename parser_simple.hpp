@@ -74,7 +74,7 @@ class is_char : public char_pred {
 
 public:
     explicit is_char(char const c)
-        : k(c), char_pred("'" + string(1, c) + "'")  {}
+        : char_pred("'" + string(1, c) + "'"), k(c) {}
     virtual bool operator() (int const c) const override {
         return k == c;
     }
@@ -86,7 +86,7 @@ class is_either : public char_pred {
 
 public:
     is_either(char_pred const &a, char_pred const& b)
-        : a(a), b(b), char_pred("(" + a.name + " or " + b.name + ")") {}
+        : char_pred("(" + a.name + " or " + b.name + ")"), a(a), b(b) {}
     bool operator() (int const c) const {
         return a(c) || b(c);
     }
@@ -97,7 +97,7 @@ class is_not : public char_pred {
 
 public:
     explicit is_not(char_pred const &a) 
-        : a(a), char_pred("~" + a.name) {}
+        : char_pred("~" + a.name), a(a) {}
     bool operator() (int const c) const {
         return !a(c);
     }
@@ -114,12 +114,12 @@ struct parse_error : public runtime_error {
     int const sym;
     string const exp;
     parse_error(string const& what, int row, int col, string exp, int sym)
-        : runtime_error(what), row(row), col(col), exp(move(exp)), sym(sym) {}
+        : runtime_error(what), row(row), col(col), sym(sym), exp(move(exp)) {}
 };
 
 class parser {
     streambuf *in;
-    int count;
+    size_t count;
     int row;
     int col;
     int sym;
@@ -152,7 +152,7 @@ protected:
         return row;
     }
 
-    int get_count() {
+    size_t get_count() {
         return count;
     }
     
@@ -1,57 +1,428 @@
 //----------------------------------------------------------------------------
 // copyright 2012, 2013, 2014 Keean Schupke
-// compile with c++ -std=c++11 
+// compile with c++ -std=c++11
 // profile.h
 
 #ifndef PROFILE_HPP
 #define PROFILE_HPP
 
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <ctime>
+#include <string>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <limits>
+#include <algorithm>
+#include <ostream>
 
 extern "C" {
     #include <sys/resource.h>
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
 }
 
-inline uint64_t rtime() {
+//----------------------------------------------------------------------------
+// Clocks: monotonic wall time and the calling thread's CPU time, both in
+// nanoseconds, and the peak resident set size of the process in kilobytes.
+
+inline uint64_t wall_ns() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return 1000000000 * static_cast<uint64_t>(t.tv_sec) + static_cast<uint64_t>(t.tv_nsec);
+}
+
+inline uint64_t cpu_ns() {
+    struct timespec t;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+    return 1000000000 * static_cast<uint64_t>(t.tv_sec) + static_cast<uint64_t>(t.tv_nsec);
+}
+
+inline uint64_t peak_rss_kb() {
     struct rusage rusage;
     getrusage(RUSAGE_SELF, &rusage);
-    return 1000000 * static_cast<uint64_t>(rusage.ru_utime.tv_sec)
-        + static_cast<uint64_t>(rusage.ru_utime.tv_usec);
+    return static_cast<uint64_t>(rusage.ru_maxrss);
 }
 
-template <typename T> class profile {
-    static uint64_t t;
-    static uint64_t s;
+//----------------------------------------------------------------------------
+// Perf Counters: hardware counters for the calling thread, user space only,
+// opened as one group so they are scheduled together. Counters the kernel or
+// hardware does not allow (perf_event_paranoid, virtual machines, other
+// platforms) are reported as missing; if the group was multiplexed the values
+// are scaled by the fraction of time it was running.
 
+class perf_counters {
 public:
-    profile() {
-        start();
+    enum event {cycles, instructions, branch_misses, cache_misses, events};
+
+    static char const* name(int const e) {
+        static char const* const names[] = {"cycles", "instructions", "branch-misses", "cache-misses"};
+        return names[e];
     }
 
-    ~profile() {
-        finish();
+private:
+    int fd[events];
+    int slot[events];
+    int open;
+    int leader;
+
+public:
+    perf_counters(perf_counters const&) = delete;
+    perf_counters& operator= (perf_counters const&) = delete;
+
+    perf_counters() : open(0), leader(-1) {
+        for (int e = 0; e < events; ++e) {
+            fd[e] = -1;
+            slot[e] = -1;
+        }
+#ifdef __linux__
+        static uint64_t const config[] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_BRANCH_MISSES,
+            PERF_COUNT_HW_CACHE_MISSES
+        };
+        for (int e = 0; e < events; ++e) {
+            struct perf_event_attr a;
+            memset(&a, 0, sizeof(a));
+            a.size = sizeof(a);
+            a.type = PERF_TYPE_HARDWARE;
+            a.config = config[e];
+            a.exclude_kernel = 1;
+            a.exclude_hv = 1;
+            a.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            int const group = (leader < 0) ? -1 : fd[leader];
+            fd[e] = static_cast<int>(syscall(__NR_perf_event_open, &a, 0, -1, group, 0));
+            if (fd[e] >= 0) {
+                slot[e] = open++;
+                if (leader < 0) {
+                    leader = e;
+                }
+            }
+        }
+#endif
     }
 
-    static void start() {
-        s = rtime();
+    ~perf_counters() {
+#ifdef __linux__
+        for (int e = 0; e < events; ++e) {
+            if (fd[e] >= 0) {
+                close(fd[e]);
+            }
+        }
+#endif
     }
 
-    static void finish() {
-        uint64_t const u = rtime();
-        t += u - s;
-        s = u;
+    bool has(int const e) const {
+        return slot[e] >= 0;
     }
 
-    static void reset() {
-        t = 1;
+    // Current counts, zero for missing counters.
+    void read(uint64_t (&v)[events]) const {
+        for (int e = 0; e < events; ++e) {
+            v[e] = 0;
+        }
+#ifdef __linux__
+        uint64_t buf[3 + events];
+        if (open == 0 || ::read(fd[leader], buf, sizeof(buf)) < static_cast<ssize_t>((3 + open) * sizeof(uint64_t))) {
+            return;
+        }
+        double const scale = (buf[2] == 0) ? 0.0 : static_cast<double>(buf[1]) / static_cast<double>(buf[2]);
+        for (int e = 0; e < events; ++e) {
+            if (slot[e] >= 0) {
+                v[e] = static_cast<uint64_t>(static_cast<double>(buf[3 + slot[e]]) * scale);
+            }
+        }
+#endif
     }
+};
+
+//----------------------------------------------------------------------------
+// Latency Histogram: log-linear buckets, each power of two split in eight, so
+// percentiles are within 12.5% (the bucket's upper bound is reported). The
+// maximum is exact.
+
+class latency_histogram {
+public:
+    static int const sub_bits = 3;
+    static int const buckets = (64 - sub_bits + 1) << sub_bits;
 
-    static uint64_t report() {
-        return t;
+    static int bucket(uint64_t const v) {
+        if (v < (1u << sub_bits)) {
+            return static_cast<int>(v);
+        }
+        int const e = 63 - __builtin_clzll(v);
+        return ((e - sub_bits + 1) << sub_bits) + static_cast<int>((v >> (e - sub_bits)) & ((1u << sub_bits) - 1));
+    }
+
+    static uint64_t upper_bound(int const b) {
+        if (b < (1 << sub_bits)) {
+            return static_cast<uint64_t>(b);
+        }
+        int const e = (b >> sub_bits) + sub_bits - 1;
+        uint64_t const m = (1u << sub_bits) + (b & ((1 << sub_bits) - 1));
+        return ((m + 1) << (e - sub_bits)) - 1;
+    }
+
+    uint64_t counts[buckets];
+    uint64_t total;
+    uint64_t max;
+
+    latency_histogram() : counts(), total(0), max(0) {}
+
+    void add(int const b, uint64_t const n) {
+        counts[b] += n;
+        total += n;
+    }
+
+    // The smallest value with at least fraction 'q' of the samples at or below it.
+    uint64_t percentile(double const q) const {
+        if (total == 0) {
+            return 0;
+        }
+        uint64_t const rank = std::max(uint64_t(1), static_cast<uint64_t>(q * total + 0.5));
+        uint64_t n = 0;
+        for (int b = 0; b < buckets; ++b) {
+            n += counts[b];
+            if (n >= rank) {
+                return std::min(upper_bound(b), max);
+            }
+        }
+        return max;
+    }
+};
+
+//----------------------------------------------------------------------------
+// Profile Report: the accumulators of all threads for one tag merged.
+// 'elapsed' is from the start of the first sample to the end of the last, the
+// wall and CPU times are summed over samples, so with several threads CPU time
+// can exceed elapsed time. Throughput is measured against elapsed time.
+
+struct profile_report {
+    uint64_t samples;
+    uint64_t elapsed_ns;
+    uint64_t wall_ns;
+    uint64_t cpu_ns;
+    uint64_t peak_rss_kb;
+    latency_histogram latency;
+    uint64_t counters[perf_counters::events];
+    bool counted[perf_counters::events];
+
+    double mb_per_s(uint64_t const bytes) const {
+        return (elapsed_ns == 0) ? 0.0 : 1000.0 * static_cast<double>(bytes) / static_cast<double>(elapsed_ns);
+    }
+
+    struct rates {
+        profile_report const& p;
+        double const mb;
+    };
+
+    // The hardware counters per megabyte of input, for printing.
+    rates per_mb(uint64_t const bytes) const {
+        return rates {*this, static_cast<double>(bytes) / 1000000.0};
     }
 };
 
-template<typename T> uint64_t profile<T>::t {1};
-template<typename T> uint64_t profile<T>::s;
+// A duration in the largest unit that keeps it at least one.
+inline std::string format_ns(uint64_t const ns) {
+    static char const* const units[] = {"ns", "us", "ms", "s"};
+    double v = static_cast<double>(ns);
+    int u = 0;
+    while (u < 3 && v >= 1000.0) {
+        v /= 1000.0;
+        ++u;
+    }
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.3g%s", v, units[u]);
+    return buf;
+}
+
+inline std::ostream& operator<< (std::ostream& out, profile_report const& p) {
+    return out << "elapsed: " << format_ns(p.elapsed_ns)
+        << " cpu: " << format_ns(p.cpu_ns)
+        << " samples: " << p.samples
+        << " p50: " << format_ns(p.latency.percentile(0.5))
+        << " p99: " << format_ns(p.latency.percentile(0.99))
+        << " max: " << format_ns(p.latency.max)
+        << " peak rss: " << p.peak_rss_kb << "KB";
+}
+
+inline std::ostream& operator<< (std::ostream& out, profile_report::rates const& r) {
+    bool any = false;
+    for (int e = 0; e < perf_counters::events; ++e) {
+        any = any || r.p.counted[e];
+    }
+    if (!any || r.mb <= 0.0) {
+        return out << "perf counters: unavailable";
+    }
+    char buf[32];
+    for (int e = 0; e < perf_counters::events; ++e) {
+        if (r.p.counted[e]) {
+            snprintf(buf, sizeof(buf), "%.4g", static_cast<double>(r.p.counters[e]) / r.mb);
+        } else {
+            snprintf(buf, sizeof(buf), "n/a");
+        }
+        out << ((e == 0) ? "" : " ") << perf_counters::name(e) << "/MB: " << buf;
+    }
+    if (r.p.counted[perf_counters::cycles] && r.p.counted[perf_counters::instructions]
+        && r.p.counters[perf_counters::cycles] > 0) {
+        snprintf(buf, sizeof(buf), "%.2f", static_cast<double>(r.p.counters[perf_counters::instructions])
+            / static_cast<double>(r.p.counters[perf_counters::cycles]));
+        out << " IPC: " << buf;
+    }
+    return out;
+}
+
+//----------------------------------------------------------------------------
+// Profile: constructing a profile<T> starts a sample for tag T on the calling
+// thread and destroying it ends the sample. Each thread accumulates into its
+// own counters, which report() merges; the counters have a single writer so
+// relaxed atomics make reading them from another thread safe. Each thread also
+// opens its hardware counters once, and a sample adds their difference.
+
+template <typename T> class profile {
+    struct accumulator {
+        std::atomic<uint64_t> samples;
+        std::atomic<uint64_t> first;
+        std::atomic<uint64_t> last;
+        std::atomic<uint64_t> wall;
+        std::atomic<uint64_t> cpu;
+        std::atomic<uint64_t> max;
+        std::atomic<uint64_t> counts[latency_histogram::buckets];
+        std::atomic<uint64_t> events[perf_counters::events];
+        perf_counters perf;
+
+        accumulator() {
+            clear();
+        }
+
+        void clear() {
+            samples.store(0, std::memory_order_relaxed);
+            first.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+            last.store(0, std::memory_order_relaxed);
+            wall.store(0, std::memory_order_relaxed);
+            cpu.store(0, std::memory_order_relaxed);
+            max.store(0, std::memory_order_relaxed);
+            for (auto& c : counts) {
+                c.store(0, std::memory_order_relaxed);
+            }
+            for (auto& e : events) {
+                e.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        static void add(std::atomic<uint64_t>& a, uint64_t const v) {
+            a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+        }
+
+        void record(uint64_t const start, uint64_t const end, uint64_t const c,
+            uint64_t const (&hw_start)[perf_counters::events], uint64_t const (&hw_end)[perf_counters::events]
+        ) {
+            uint64_t const w = end - start;
+            add(samples, 1);
+            if (start < first.load(std::memory_order_relaxed)) {
+                first.store(start, std::memory_order_relaxed);
+            }
+            last.store(end, std::memory_order_relaxed);
+            add(wall, w);
+            add(cpu, c);
+            if (w > max.load(std::memory_order_relaxed)) {
+                max.store(w, std::memory_order_relaxed);
+            }
+            add(counts[latency_histogram::bucket(w)], 1);
+            for (int e = 0; e < perf_counters::events; ++e) {
+                add(events[e], hw_end[e] - hw_start[e]);
+            }
+        }
+    };
+
+    struct registry {
+        std::mutex m;
+        std::deque<accumulator> threads;
+    };
+
+    static registry& all() {
+        static registry r;
+        return r;
+    }
+
+    static accumulator& local() {
+        static thread_local accumulator* a = nullptr;
+        if (a == nullptr) {
+            registry& r = all();
+            std::lock_guard<std::mutex> lock(r.m);
+            r.threads.emplace_back();
+            a = &r.threads.back();
+        }
+        return *a;
+    }
+
+    accumulator& a;
+    uint64_t hw[perf_counters::events];
+    uint64_t w;
+    uint64_t c;
+
+public:
+    profile(profile const&) = delete;
+
+    profile() : a(local()) {
+        a.perf.read(hw);
+        w = wall_ns();
+        c = cpu_ns();
+    }
+
+    ~profile() {
+        uint64_t const c_end = cpu_ns();
+        uint64_t const w_end = wall_ns();
+        uint64_t hw_end[perf_counters::events];
+        a.perf.read(hw_end);
+        a.record(w, w_end, c_end - c, hw, hw_end);
+    }
+
+    static void reset() {
+        registry& r = all();
+        std::lock_guard<std::mutex> lock(r.m);
+        for (accumulator& a : r.threads) {
+            a.clear();
+        }
+    }
+
+    static profile_report report() {
+        profile_report p {0, 0, 0, 0, peak_rss_kb(), latency_histogram(), {}, {}};
+        bool all_counted[perf_counters::events] = {true, true, true, true};
+        uint64_t first = std::numeric_limits<uint64_t>::max();
+        uint64_t last = 0;
+        registry& r = all();
+        std::lock_guard<std::mutex> lock(r.m);
+        for (accumulator const& a : r.threads) {
+            p.samples += a.samples.load(std::memory_order_relaxed);
+            p.wall_ns += a.wall.load(std::memory_order_relaxed);
+            p.cpu_ns += a.cpu.load(std::memory_order_relaxed);
+            p.latency.max = std::max(p.latency.max, a.max.load(std::memory_order_relaxed));
+            first = std::min(first, a.first.load(std::memory_order_relaxed));
+            last = std::max(last, a.last.load(std::memory_order_relaxed));
+            for (int b = 0; b < latency_histogram::buckets; ++b) {
+                p.latency.add(b, a.counts[b].load(std::memory_order_relaxed));
+            }
+            if (a.samples.load(std::memory_order_relaxed) > 0) {
+                for (int e = 0; e < perf_counters::events; ++e) {
+                    p.counters[e] += a.events[e].load(std::memory_order_relaxed);
+                    all_counted[e] = all_counted[e] && a.perf.has(e);
+                }
+            }
+        }
+        p.elapsed_ns = (last > first) ? last - first : 0;
+        // a counter is only meaningful if every thread that took samples had it.
+        for (int e = 0; e < perf_counters::events; ++e) {
+            p.counted[e] = p.samples > 0 && all_counted[e];
+        }
+        return p;
+    }
+};
 
 #endif // PROFILE_HPP
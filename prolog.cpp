@@ -6,6 +6,7 @@ struct base {};
 using lp = logic_parser<base>;
 
 struct expression_parser;
+struct snapshot_loader;
 
 template <typename Range>
 int parse(Range const &r, lp::program& prog) {
@@ -13,6 +14,13 @@ int parse(Range const &r, lp::program& prog) {
     return lp::parse(r, prog);
 }
 
+void show(lp::program const& prog) {
+    cout << prog;
+    cout << "clauses: " << prog.db.size() << " goals: " << prog.goals.size()
+        << " predicates: " << prog.db.predicates().size()
+        << " cells: " << prog.cell_count() << endl;
+}
+
 //----------------------------------------------------------------------------
 // The stream_range allows file iterators to be used like random_iterators
 // and abstracts the difference between C++ stdlib streams and file_vectors.
@@ -22,15 +30,48 @@ int main(int const argc, char const *argv[]) {
     if (argc < 1) {
         cerr << "no input files" << endl;
     } else {
+        // set PARSER_TRACE to a file name to record a trace of the last input.
+        char const* const trace = getenv("PARSER_TRACE");
+        // set PROLOG_SNAPSHOT to load each input from FILE.snap when that is
+        // up to date, and to parse it and write FILE.snap otherwise.
+        bool const snapshot = getenv("PROLOG_SNAPSHOT") != nullptr;
         for (int i = 1; i < argc; ++i) {
-            profile<expression_parser>::reset();
-            stream_range in(argv[i]);
             cout << argv[i] << endl;
             lp::program prog;
+            string const image = string(argv[i]) + ".snap";
+            if (snapshot) {
+                profile<snapshot_loader>::reset();
+                bool loaded;
+                {
+                    profile<snapshot_loader> p;
+                    loaded = lp::load_snapshot(prog, argv[i], image.c_str());
+                }
+                if (loaded) {
+                    show(prog);
+                    cout << "loaded " << image << ": " << profile<snapshot_loader>::report() << endl;
+                    continue;
+                }
+            }
+
+            profile<expression_parser>::reset();
+            if (trace != nullptr) {
+                parser_trace::start();
+            }
+            stream_range in(argv[i]);
             int const chars_read = parse(in, prog);
-            cout << prog;
-            double const mb_per_s = static_cast<double>(chars_read) / static_cast<double>(profile<expression_parser>::report());
-            cout << "parsed: " << mb_per_s << "MB/s" << endl;
+            // only a program parsed from the whole of its source is saved.
+            if (snapshot && chars_read == ifstream(argv[i], ios_base::binary | ios_base::ate).tellg()) {
+                lp::save_snapshot(prog, argv[i], image.c_str());
+            }
+            show(prog);
+            profile_report const report = profile<expression_parser>::report();
+            cout << "parsed: " << report.mb_per_s(chars_read) << "MB/s" << endl << report << endl;
+            cout << report.per_mb(chars_read) << endl;
+            if (trace != nullptr) {
+                parser_trace::stop();
+                ofstream out(trace, ios_base::out | ios_base::binary);
+                parser_trace::write(out);
+            }
         }
     }
 }
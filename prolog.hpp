@@ -1,13 +1,28 @@
 #include <string>
 #include <sstream>
+#include <fstream>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
 #include <iostream>
 #include <vector>
+#include <array>
 #include <set>
 #include <map>
+#include <unordered_map>
+#include <iterator>
+#include <memory>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
 
 #include "stream_iterator.hpp"
 #include "templateio.hpp"
 #include "profile.hpp"
+#include "arena.hpp"
+#include "memory_range.hpp"
 
 // This is a work around for the "static auto constexpr" initialisation bug 
 // in g++ and clang++.
@@ -29,22 +44,257 @@ using namespace std;
 //----------------------------------------------------------------------------
 // Syntactic Structure.
 //
-// A global set of names keeps string comparisons for atoms and varibles to
-// a single iterator (pointer) comparison. A single type is used for atoms
-// and structs, which is combined with a variable type in an expression 
-// supertype. Clauses combine heads and goals, and keep track of repeated 
-// variables in the head for efficient post-unification cycle checking.
+// Names of atoms and variables are interned in the program's atom table, so
+// comparing them is a single integer comparison, and maps keyed on them can
+// be arrays indexed by the atom's dense ID.
+//
+// Terms are stored as in a WAM heap, an array of tagged 64 bit cells. A
+// compound is a functor cell, holding its name and arity, followed by a cell
+// for each argument. A term is a single cell: a reference to a compound's
+// functor cell, an atom (a compound with no arguments), or a variable. The
+// first cell of a variable refers to itself, and its other occurrences refer
+// to that cell; both carry its name for printing. Clauses combine heads and
+// goals, and keep track of repeated variables in the head for efficient
+// post-unification cycle checking; the goals and repeated variables are a
+// run of cells. Cells refer to each other by index, so the heap holds no
+// pointers and may grow.
+//
+// The term nodes (variable and compound, derived from Base through managed)
+// and term_visitor are views of the cells, built on demand by program::node
+// in the program's region, a bump arena. A node is built once per term, so
+// the occurrences of a variable share one node, and nodes never move, and are
+// never destroyed: Base must not own resources. A compound's arguments and a
+// clause node's goals and repeated variables are arrays in the region, read
+// through region_array.
 
 template <typename Base> struct logic_parser {
 
-    using atom_t = std::set<std::string>::const_iterator;
+    using atom_t = uint32_t;
 
     struct atom_less {
-        bool operator() (atom_t const& x, atom_t const& y) const {
-            return &(*x) < &(*y);
+        bool operator() (atom_t const x, atom_t const y) const {
+            return x < y;
+        }
+    };
+
+    // Interns names as dense IDs, numbered from zero in order of first use.
+    // Lookup is open addressing with linear probing on a table of ID + 1 (0
+    // is empty) and the high half of the hash, kept at most half full. The
+    // names are NUL terminated in a bump arena, so they never move, or are
+    // adopted in place from a snapshot.
+    class atom_table {
+        struct name_t {
+            char const* text;
+            uint32_t size;
+        };
+
+        parse_arena text;
+        vector<name_t> names;
+        vector<uint64_t> slots;
+
+        static uint32_t hash(char const* s, size_t n) {
+            uint32_t h = 2166136261u;
+            while (n-- > 0) {
+                h = (h ^ static_cast<unsigned char>(*s++)) * 16777619u;
+            }
+            return h;
+        }
+
+        void grow() {
+            vector<uint64_t> old(max<size_t>(64, slots.size() * 2), 0);
+            old.swap(slots);
+            size_t const mask = slots.size() - 1;
+            for (uint64_t const e : old) {
+                if (e != 0) {
+                    size_t i = (e >> 32) & mask;
+                    while (slots[i] != 0) {
+                        i = (i + 1) & mask;
+                    }
+                    slots[i] = e;
+                }
+            }
+        }
+
+        atom_t insert(char const* s, size_t const n, bool const copy) {
+            if (2 * (names.size() + 1) > slots.size()) {
+                grow();
+            }
+            uint32_t const h = hash(s, n);
+            size_t const mask = slots.size() - 1;
+            size_t i = h & mask;
+            for (; slots[i] != 0; i = (i + 1) & mask) {
+                if ((slots[i] >> 32) == h) {
+                    atom_t const a = static_cast<atom_t>(slots[i] - 1);
+                    if (names[a].size == n && memcmp(names[a].text, s, n) == 0) {
+                        return a;
+                    }
+                }
+            }
+            if (copy) {
+                char* const t = static_cast<char*>(text.allocate(n + 1));
+                memcpy(t, s, n);
+                t[n] = '\0';
+                s = t;
+            }
+            atom_t const a = static_cast<atom_t>(names.size());
+            names.push_back(name_t {s, static_cast<uint32_t>(n)});
+            slots[i] = (static_cast<uint64_t>(h) << 32) | (a + 1);
+            return a;
+        }
+
+    public:
+        atom_t intern(char const* s, size_t const n) {
+            return insert(s, n, true);
+        }
+
+        // interns the NUL terminated 's' without copying it.
+        atom_t adopt(char const* s, size_t const n) {
+            return insert(s, n, false);
+        }
+
+        atom_t intern(string const& s) {
+            return intern(s.data(), s.size());
+        }
+
+        char const* name(atom_t const a) const {
+            return names[a].text;
+        }
+
+        void clear() {
+            text.release();
+            names.clear();
+            slots.clear();
+        }
+
+        size_t size() const {
+            return names.size();
+        }
+    };
+
+    // A tagged cell: the low three bits are the tag. Variables hold the
+    // index of their first cell and their name, references to compounds the
+    // index of the functor cell, atoms the atom, and functors the atom and
+    // arity. Indexes and atoms have 32 bits, variable names and arities the
+    // 29 above them; a name or arity that does not fit throws.
+    class cell {
+        uint64_t bits;
+
+        explicit cell(uint64_t const b) : bits(b) {}
+
+        static uint64_t high(size_t const x) {
+            if (x >= max_high) {
+                throw runtime_error("variable name or arity too large for a cell");
+            }
+            return static_cast<uint64_t>(x) << 35;
+        }
+
+    public:
+        enum tag_t {ref, str, con, fun};
+
+        static uint64_t const max_high = uint64_t(1) << 29;
+
+        cell() : bits(0) {}
+
+        static cell variable(uint32_t const at, atom_t const name) {
+            return cell(ref | (static_cast<uint64_t>(at) << 3) | high(name));
+        }
+
+        static cell structure(uint32_t const at) {
+            return cell(str | (static_cast<uint64_t>(at) << 3));
+        }
+
+        static cell constant(atom_t const a) {
+            return cell(con | (static_cast<uint64_t>(a) << 3));
+        }
+
+        static cell functor(atom_t const a, size_t const arity) {
+            return cell(fun | (static_cast<uint64_t>(a) << 3) | high(arity));
+        }
+
+        tag_t tag() const {
+            return static_cast<tag_t>(bits & 7);
+        }
+
+        // the cell referred to by a variable or compound.
+        uint32_t index() const {
+            return static_cast<uint32_t>(bits >> 3);
+        }
+
+        // the name of a variable, atom or functor.
+        atom_t atom() const {
+            return static_cast<atom_t>((tag() == ref) ? bits >> 35 : bits >> 3);
+        }
+
+        size_t arity() const {
+            return static_cast<size_t>(bits >> 35);
+        }
+
+        uint64_t raw() const {
+            return bits;
+        }
+    };
+
+    static_assert(sizeof(cell) == 8, "cells must be 64 bits");
+
+    // orders variables by their first occurrence.
+    struct variable_less {
+        bool operator() (cell const x, cell const y) const {
+            return x.index() < y.index();
+        }
+    };
+
+    // A read only view of an array, standing in for a const vector. A run of
+    // cells is valid until the heap grows; region arrays never move.
+    template <typename T> class region_array {
+        T const* first;
+        size_t n;
+
+    public:
+        using const_iterator = T const*;
+
+        region_array(T const* f, size_t n) : first(f), n(n) {}
+
+        size_t size() const {
+            return n;
+        }
+
+        bool empty() const {
+            return n == 0;
+        }
+
+        T const& operator[] (size_t i) const {
+            return first[i];
+        }
+
+        const_iterator begin() const {
+            return first;
+        }
+
+        const_iterator end() const {
+            return first + n;
+        }
+
+        const_iterator cbegin() const {
+            return first;
         }
+
+        const_iterator cend() const {
+            return first + n;
+        }
+    };
+
+    using cell_range = region_array<cell>;
+
+    // The goals, then the repeated variables, are cells from 'body'.
+    struct clause {
+        cell head;
+        uint32_t body;
+        uint32_t goals;
+        uint32_t reps;
     };
 
+    using heap_t = cell const*;
+
     struct managed : public Base {
         virtual ~managed() {}
     };
@@ -62,7 +312,7 @@ template <typename Base> struct logic_parser {
         virtual ~term() {}
     };
 
-    class program; 
+    class program;
 
     struct variable : public term {
         atom_t const atom;
@@ -74,131 +324,451 @@ template <typename Base> struct logic_parser {
         variable(atom_t n) : atom(n) {}
     };
 
+    // an atom is a compound with no arguments.
     struct compound : public term {
         atom_t const functor;
-        vector<term*> const args;
+        region_array<term*> const args;
         virtual void accept(term_visitor* v) override {
             v->visit(this);
         }
     private:
         friend program;
-        template <typename As> compound(atom_t f, As&& as) : functor(f),
-            args(forward<As>(as)) {}
+        compound(atom_t f, region_array<term*> as) : functor(f), args(as) {}
     };
 
-
-    struct clause : public managed {
+    struct clause_node : public managed {
         compound* const head;
-        vector<compound*> const impl;
-        set<variable*> const reps;
+        region_array<compound*> const impl;
+        region_array<variable*> const reps;
 
     private:
-        friend class program;
-        template <typename Is, typename Rs>
-        clause(compound* h, Is&& is, Rs&& rs) : head(h),
-            impl(forward<Is>(is)), reps(forward<Rs>(rs)) {}
+        friend program;
+        clause_node(compound* h, region_array<compound*> is, region_array<variable*> rs)
+            : head(h), impl(is), reps(rs) {}
     };
 
-    class program {
-        vector<unique_ptr<managed>> region;
+    // The arguments of a term, none unless it is a compound.
+    static cell_range args_of(heap_t const heap, cell const t) {
+        if (t.tag() != cell::str) {
+            return cell_range(nullptr, 0);
+        }
+        return cell_range(&heap[t.index() + 1], heap[t.index()].arity());
+    }
+
+    //------------------------------------------------------------------------
+    // Clause Index
+    //
+    // Clauses are indexed by the functor and arity of their head, and within
+    // a predicate by the principal functor (functor and arity) of their first
+    // argument. A predicate keeps the positions of its clauses with a variable
+    // (or no) first argument, of those with a bound one, and of those with
+    // each principal functor. A lookup is two hash probes, and merges the
+    // unbound positions with the bound ones, or one functor's, so it yields
+    // in insertion order just the clauses whose head can match on the first
+    // argument.
+
+    using index_key = uint64_t;
+
+    // The principal functor of a term, as its functor cell, if the term is
+    // not a variable.
+    static bool principal(heap_t const heap, cell const t, index_key& key) {
+        switch (t.tag()) {
+            case cell::con:
+                key = cell::functor(t.atom(), 0).raw();
+                return true;
+            case cell::str:
+                key = heap[t.index()].raw();
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    using positions = vector<uint32_t>;
+
+    // The clauses named by the merge of two ascending position lists. It
+    // refers to the clause and position vectors of a predicate in the index,
+    // so it, and its iterators, are invalidated by the next insert.
+    class clause_matches {
+        clause const* clauses;
+        positions const& xs;
+        positions const& ys;
+
+    public:
+        class const_iterator {
+            clause const* clauses;
+            uint32_t const* a;
+            uint32_t const* a_end;
+            uint32_t const* b;
+            uint32_t const* b_end;
+
+            bool take_a() const {
+                return b == b_end || (a != a_end && *a < *b);
+            }
+
+        public:
+            using iterator_category = forward_iterator_tag;
+            using value_type = clause;
+            using difference_type = ptrdiff_t;
+            using pointer = clause const*;
+            using reference = clause const&;
+
+            const_iterator(clause const* cs, uint32_t const* a, uint32_t const* a_end,
+                uint32_t const* b, uint32_t const* b_end)
+                : clauses(cs), a(a), a_end(a_end), b(b), b_end(b_end) {}
+
+            clause const& operator* () const {
+                return clauses[take_a() ? *a : *b];
+            }
+
+            const_iterator& operator++ () {
+                if (take_a()) {
+                    ++a;
+                } else {
+                    ++b;
+                }
+                return *this;
+            }
+
+            const_iterator operator++ (int) {
+                const_iterator const i = *this;
+                ++(*this);
+                return i;
+            }
+
+            bool operator== (const_iterator const& that) const {
+                return a == that.a && b == that.b;
+            }
+
+            bool operator!= (const_iterator const& that) const {
+                return !(*this == that);
+            }
+        };
+
+        clause_matches(clause const* cs, positions const& xs, positions const& ys)
+            : clauses(cs), xs(xs), ys(ys) {}
+
+        const_iterator begin() const {
+            return const_iterator(clauses, xs.data(), xs.data() + xs.size(), ys.data(), ys.data() + ys.size());
+        }
+
+        const_iterator end() const {
+            uint32_t const* const a = xs.data() + xs.size();
+            uint32_t const* const b = ys.data() + ys.size();
+            return const_iterator(clauses, a, a, b, b);
+        }
+
+        size_t size() const {
+            return xs.size() + ys.size();
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+    };
+
+    class clause_index {
+    public:
+        struct predicate {
+            atom_t functor;
+            size_t arity;
+            vector<clause> clauses;
+            positions unbound;
+            positions bound;
+            unordered_map<index_key, positions> first;
+        };
+
+    private:
+        vector<predicate> preds;
+        unordered_map<index_key, size_t> keys;
+        size_t count;
 
     public:
-        set<string> atoms;
-        multimap<atom_t, struct clause*, atom_less> db;
-        vector<clause*> goals;
+        clause_index() : count(0) {}
+
+        void insert(heap_t const heap, clause const& c) {
+            index_key head;
+            if (!principal(heap, c.head, head)) {
+                throw runtime_error("clause head is not an atom or compound");
+            }
+            auto const k = keys.emplace(head, preds.size());
+            if (k.second) {
+                cell const f = (c.head.tag() == cell::str) ? heap[c.head.index()] : cell::functor(c.head.atom(), 0);
+                preds.push_back(predicate {f.atom(), f.arity(), {}, {}, {}, {}});
+            }
+            predicate& p = preds[k.first->second];
+            uint32_t const n = static_cast<uint32_t>(p.clauses.size());
+            p.clauses.push_back(c);
+            ++count;
+            cell_range const args = args_of(heap, c.head);
+            index_key first;
+            if (!args.empty() && principal(heap, args[0], first)) {
+                p.bound.push_back(n);
+                p.first[first].push_back(n);
+            } else {
+                p.unbound.push_back(n);
+            }
+        }
+
+        predicate const* find(atom_t const functor, size_t const arity) const {
+            auto const k = keys.find(cell::functor(functor, arity).raw());
+            return (k == keys.end()) ? nullptr : &preds[k->second];
+        }
+
+        // The clauses that may match 'goal', in the order they were added.
+        // The result is a view of the index, valid until the next insert.
+        clause_matches lookup(heap_t const heap, cell const goal) const {
+            static positions const none;
+            index_key key;
+            auto const k = principal(heap, goal, key) ? keys.find(key) : keys.end();
+            if (k == keys.end()) {
+                return clause_matches(nullptr, none, none);
+            }
+            predicate const& p = preds[k->second];
+            cell_range const args = args_of(heap, goal);
+            index_key first;
+            if (args.empty() || !principal(heap, args[0], first)) {
+                return clause_matches(p.clauses.data(), p.unbound, p.bound);
+            }
+            auto const b = p.first.find(first);
+            return clause_matches(p.clauses.data(), p.unbound, (b == p.first.end()) ? none : b->second);
+        }
+
+        // predicates in the order first defined.
+        vector<predicate> const& predicates() const {
+            return preds;
+        }
+
+        size_t size() const {
+            return count;
+        }
+    };
+
+    // A program's cells are its own while it is parsed, or are read in place
+    // from a mapped snapshot, which it keeps alive; a program loaded from a
+    // snapshot is read only, and adding terms or clauses to it throws.
+    class program {
+        vector<cell> cells;
+        heap_t base;
+        size_t size;
+        shared_ptr<void const> image;
+        parse_arena region;
+        unordered_map<uint64_t, term*> nodes;
+
+        template <typename T> T* new_array(size_t const n) {
+            return static_cast<T*>(region.allocate(n * sizeof(T)));
+        }
+
+        // the index of the next cell; every addition to the heap starts here.
+        uint32_t top() const {
+            if (image) {
+                throw runtime_error("program loaded from a snapshot is read only");
+            }
+            return static_cast<uint32_t>(cells.size());
+        }
 
-        variable* new_variable(atom_t n) {
-            variable* v = new variable(n);
-            region.emplace_back(v);
+        // cells are indexed with 32 bits.
+        void room_for(size_t const n) const {
+            if (n > numeric_limits<uint32_t>::max() - cells.size()) {
+                throw runtime_error("program heap is full");
+            }
+        }
+
+        template <typename C> void append(C const& c) {
+            cells.insert(cells.end(), c.begin(), c.end());
+        }
+
+        void grown() {
+            base = cells.data();
+            size = cells.size();
+        }
+
+    public:
+        atom_table atoms;
+        clause_index db;
+        vector<clause> goals;
+
+        program() : base(nullptr), size(0) {}
+        program(program const&) = delete;
+        program& operator= (program const&) = delete;
+
+        cell new_variable(atom_t n) {
+            cell const v = cell::variable(top(), n);
+            room_for(1);
+            cells.push_back(v);
+            grown();
             return v;
         }
 
-        template <typename As> compound* new_compound(atom_t n, As&& as) {
-            compound* c = new compound(n, forward<As>(as));
-            region.emplace_back(c);
+        template <typename As> cell new_compound(atom_t n, As const& as) {
+            if (as.size() == 0) {
+                return cell::constant(n);
+            }
+            cell const c = cell::structure(top());
+            room_for(1 + as.size());
+            cells.push_back(cell::functor(n, as.size()));
+            append(as);
+            grown();
             return c;
         }
 
         template <typename Is, typename Rs>
-        class clause* new_clause(compound* h, Is&& is, Rs&& rs) {
-            clause* c = new clause(h, forward<Is>(is), forward<Rs>(rs));
-            region.emplace_back(c);
+        clause new_clause(cell h, Is const& is, Rs const& rs) {
+            clause const c {h, top(), static_cast<uint32_t>(is.size()), static_cast<uint32_t>(rs.size())};
+            room_for(is.size() + rs.size());
+            append(is);
+            append(rs);
+            grown();
             return c;
         }
-    };
 
-    //------------------------------------------------------------------------
-    // Show Abstract Syntax
+        // uses 'n' cells at 'cs', kept alive by 'owner', in place.
+        void adopt_cells(shared_ptr<void const> owner, cell const* cs, size_t n) {
+            cells.clear();
+            image = move(owner);
+            base = cs;
+            size = n;
+        }
 
-    class expr_show : public term_visitor {
-        ostream& out;
+        heap_t heap() const {
+            return base;
+        }
+
+        size_t cell_count() const {
+            return size;
+        }
+
+        cell_range args(cell const t) const {
+            return args_of(base, t);
+        }
+
+        cell_range goals_of(clause const& c) const {
+            return cell_range(base + c.body, c.goals);
+        }
+
+        cell_range reps_of(clause const& c) const {
+            return cell_range(base + c.body + c.goals, c.reps);
+        }
 
-        virtual void visit(variable* t) override {
-            out << *(t->atom);
+        clause_matches lookup(cell const goal) const {
+            return db.lookup(base, goal);
         }
 
-        virtual void visit(compound* t) override {
-            if (::ispunct((*(t->functor))[0]) && t->args.size() == 2) {
-                t->args[0]->accept(this);
-                cout << " " << *(t->functor) << " ";
-                t->args[1]->accept(this);
+        // The node of term 't', built with the nodes of its subterms the
+        // first time it is asked for.
+        term* node(cell const t) {
+            auto const k = nodes.find(t.raw());
+            if (k != nodes.end()) {
+                return k->second;
+            }
+            term* n;
+            if (t.tag() == cell::ref) {
+                n = new (region.allocate(sizeof(variable))) variable(t.atom());
             } else {
-                out << *(t->functor);
-                if (t->args.size() > 0) {
-                    out << "(";
-                    for (auto i = t->args.cbegin(); i != t->args.cend(); ++i) {
-                        (*i)->accept(this);
-                        auto j = i;
-                        if (++j != t->args.end()) {
-                            out << ", ";
-                        }
-                    }
-                    out << ")";
+                cell_range const as = args(t);
+                term** const a = new_array<term*>(as.size());
+                for (size_t i = 0; i < as.size(); ++i) {
+                    a[i] = node(as[i]);
                 }
+                atom_t const f = (t.tag() == cell::str) ? base[t.index()].atom() : t.atom();
+                n = new (region.allocate(sizeof(compound))) compound(f, region_array<term*>(a, as.size()));
+            }
+            nodes.emplace(t.raw(), n);
+            return n;
+        }
+
+        // A new node of clause 'c', sharing the term nodes of its terms.
+        clause_node* node(clause const& c) {
+            cell_range const gs = goals_of(c);
+            cell_range const rs = reps_of(c);
+            compound** const impl = new_array<compound*>(gs.size());
+            for (size_t i = 0; i < gs.size(); ++i) {
+                impl[i] = static_cast<compound*>(node(gs[i]));
             }
+            variable** const reps = new_array<variable*>(rs.size());
+            for (size_t i = 0; i < rs.size(); ++i) {
+                reps[i] = static_cast<variable*>(node(rs[i]));
+            }
+            return new (region.allocate(sizeof(clause_node))) clause_node(static_cast<compound*>(node(c.head)),
+                region_array<compound*>(impl, gs.size()), region_array<variable*>(reps, rs.size()));
+        }
+
+        // bytes of the region in use, and reserved from the heap.
+        size_t region_used() const {
+            return region.used();
+        }
+
+        size_t region_reserved() const {
+            return region.reserved();
         }
+    };
+
+    //------------------------------------------------------------------------
+    // Show Abstract Syntax
+    //
+    // Atoms are only names in a program, so terms and clauses are shown
+    // with the program's atom table.
+
+    class expr_show {
+        ostream& out;
+        program const& p;
 
     public:
-        expr_show(ostream& out) : out(out) {}
+        expr_show(ostream& out, program const& p) : out(out), p(p) {}
 
-        void operator() (term* t) {
-            t->accept(this);
+        void operator() (cell const t) {
+            if (t.tag() != cell::str) {
+                out << p.atoms.name(t.atom());
+                return;
+            }
+            char const* const functor = p.atoms.name(p.heap()[t.index()].atom());
+            cell_range const args = p.args(t);
+            if (::ispunct(functor[0]) && args.size() == 2) {
+                (*this)(args[0]);
+                out << " " << functor << " ";
+                (*this)(args[1]);
+            } else {
+                out << functor << "(";
+                for (auto i = args.cbegin(); i != args.cend(); ++i) {
+                    (*this)(*i);
+                    if (i + 1 != args.cend()) {
+                        out << ", ";
+                    }
+                }
+                out << ")";
+            }
         }
     };
 
-    friend  ostream& operator<< (ostream& out, term* exp) {
-        expr_show eshow(out);
-        eshow(exp);
+    static ostream& show(ostream& out, program const& p, cell const t) {
+        expr_show eshow(out, p);
+        eshow(t);
         return out;
     }
 
-    friend ostream& operator<< (ostream& out, clause* cls) {
-        expr_show eshow(out);
+    static ostream& show(ostream& out, program const& p, clause const& cls) {
+        expr_show eshow(out, p);
 
-        eshow(cls->head);
-        auto f = cls->impl.cbegin();
-        auto const l = cls->impl.cend();
-        if (f != l) {
+        eshow(cls.head);
+        cell_range const goals = p.goals_of(cls);
+        if (!goals.empty()) {
             out << " :-" << endl;
-            for (auto i = f; i != l; ++i) {
+            for (auto i = goals.cbegin(); i != goals.cend(); ++i) {
                 out << "\t";
                 eshow(*i);
-                auto j = i;
-                if (++j != l) {
+                if (i + 1 != goals.cend()) {
                     out << "," << endl;
                 }
             }
         }
         out << ".";
 
-        auto g = cls->reps.cbegin();
-        auto const m = cls->reps.cend();
-        if (g != m) {
+        cell_range const reps = p.reps_of(cls);
+        if (!reps.empty()) {
             out << " [";
-            for (auto i = g; i != m; ++i) {
+            for (auto i = reps.cbegin(); i != reps.cend(); ++i) {
                 eshow(*i);
-                auto j = i;
-                if (++j != m) {
+                if (i + 1 != reps.cend()) {
                     out << ", ";
                 }
             }
@@ -211,13 +781,15 @@ template <typename Base> struct logic_parser {
 
     friend ostream& operator<< (ostream& out, program const& p) {
         int i = 1, tab = to_string(p.db.size()).size();
-        for (auto j = p.db.cbegin(); j != p.db.cend(); ++i, ++j) {
-            string pad(" ", tab - to_string(i).size());
-            out << pad << i << ". " << j->second;
+        for (auto const& pred : p.db.predicates()) {
+            for (auto j = pred.clauses.cbegin(); j != pred.clauses.cend(); ++i, ++j) {
+                string pad(tab - to_string(i).size(), ' ');
+                show(out << pad << i << ". ", p, *j);
+            }
         }
         out << endl;
         for (auto j = p.goals.cbegin(); j != p.goals.cend(); ++j) {
-            out << *j << endl;
+            show(out, p, *j) << endl;
         }
         return out;
     }
@@ -231,25 +803,42 @@ template <typename Base> struct logic_parser {
     // parser (to ensure performance) or a safety measure to make sure we deal
     // with copying if we want backtracking.
 
-    using var_t = typename map<atom_t, variable*>::const_iterator;
-
     struct inherited_attributes {
         program& prog;
 
-        map<atom_t, variable*, atom_less> variables; 
-        set<variable*> repeated;
-        set<variable*> repeated_in_goal;
+        // the current clause's variables indexed by atom (functor cells where
+        // there are none), and their atoms in the order first seen, so they
+        // can be cleared in time proportional to the clause.
+        vector<cell> variables;
+        vector<atom_t> bound;
+        set<cell, variable_less> repeated;
+        set<cell, variable_less> repeated_in_goal;
 
         inherited_attributes(inherited_attributes const&) = delete;
         inherited_attributes& operator= (inherited_attributes const&) = delete;
 
         atom_t get_atom(string const& atom) {
-            atom_t const n = prog.atoms.find(atom);
-            if (n == prog.atoms.end()) {
-                return prog.atoms.insert(atom).first;
-            } else {
-                return n;
+            return prog.atoms.intern(atom);
+        }
+
+        cell& get_variable(atom_t const n) {
+            if (n >= variables.size()) {
+                variables.resize(prog.atoms.size(), unseen());
+            }
+            return variables[n];
+        }
+
+        static cell unseen() {
+            return cell::functor(0, 0);
+        }
+
+        void clear_clause() {
+            for (atom_t const n : bound) {
+                variables[n] = unseen();
             }
+            bound.clear();
+            repeated.clear();
+            repeated_in_goal.clear();
         }
 
         inherited_attributes(program& p) : prog(p) {}
@@ -266,28 +855,27 @@ template <typename Base> struct logic_parser {
     static struct return_variable_t {
         constexpr return_variable_t() {}
         void operator() (
-            variable** res,
+            cell* res,
             string const& atom,
             inherited_attributes* st
         ) const {
             atom_t const n = st->get_atom(atom);
-            var_t i = st->variables.find(n);
-            if (i == st->variables.end()) {
-                variable* const var = st->prog.new_variable(n);
-                st->variables.insert(make_pair(n, var));
-                *res = var;
+            cell& var = st->get_variable(n);
+            if (var.tag() == cell::fun) {
+                var = st->prog.new_variable(n);
+                st->bound.push_back(n);
             } else {
-                st->repeated.insert(i->second);
-                *res = i->second;
+                st->repeated.insert(var);
             }
+            *res = var;
         }
     } constexpr return_variable {};
 
     static struct return_args_t {
         constexpr return_args_t() {}
         void operator() (
-            vector<term*>* res,
-            term* t1,
+            vector<cell>* res,
+            cell t1,
             inherited_attributes*
         ) const {
             res->push_back(t1);
@@ -297,9 +885,9 @@ template <typename Base> struct logic_parser {
     static struct return_struct_t {
         constexpr return_struct_t() {}
         void operator() (
-            compound** res,
+            cell* res,
             string const& atom,
-            vector<term*>& args,
+            vector<cell>& args,
             inherited_attributes* st
         ) const {
             *res = st->prog.new_compound(st->get_atom(atom), args);
@@ -309,10 +897,10 @@ template <typename Base> struct logic_parser {
     static struct return_term_t {
         constexpr return_term_t() {}
         void operator() (
-            term** res,
+            cell* res,
             int n,
-            variable* v,
-            compound *s,
+            cell v,
+            cell s,
             inherited_attributes* st
         ) const {
             switch (n) {
@@ -326,34 +914,31 @@ template <typename Base> struct logic_parser {
         }
     } constexpr return_term {};
 
-    static struct return_op_exp_exp_t {
-        constexpr return_op_exp_exp_t() {}
+    static struct return_op_term_t {
+        constexpr return_op_term_t() {}
         void operator() (
-            term** res,
-            term* t1,
-            pair<string, term*> const& t2,
+            cell* res,
+            cell t1,
+            string const& oper,
+            cell t2,
             inherited_attributes* st
         ) const {
-            if (!t2.first.empty()) {
-                atom_t o = st->get_atom(t2.first);
-                vector<term*> a {t1, t2.second};
-                *res = st->prog.new_compound(o, a);
-            } else {
-                *res = t1;
-            }
+            atom_t o = st->get_atom(oper);
+            array<cell, 2> const a {{t1, t2}};
+            *res = st->prog.new_compound(o, a);
         }
-    } constexpr return_op_exp_exp {};
+    } constexpr return_op_term {};
 
     static struct return_op_var_exp_t {
         constexpr return_op_var_exp_t() {}
         void operator() (
-            compound** res,
-            variable* t1,
-            string const& oper, term* t2,
+            cell* res,
+            cell t1,
+            string const& oper, cell t2,
             inherited_attributes* st
         ) const {
             atom_t o = st->get_atom(oper);
-            vector<term*> a {t1, t2};
+            array<cell, 2> const a {{t1, t2}};
             *res = st->prog.new_compound(o, a);
         }
     } constexpr return_op_var_exp {};
@@ -361,9 +946,9 @@ template <typename Base> struct logic_parser {
     static struct return_oper_term_t {
         constexpr return_oper_term_t() {}
         void operator() (
-            pair<string, term*>* res,
+            pair<string, cell>* res,
             string const& oper,
-            term* term,
+            cell term,
             inherited_attributes* st
         ) const {
             *res = make_pair(oper, term);
@@ -373,14 +958,14 @@ template <typename Base> struct logic_parser {
     static struct return_op_stc_exp_t {
         constexpr return_op_stc_exp_t() {}
         void operator() (
-            compound** res,
-            compound* t1,
-            pair<string, term*> const& t2,
+            cell* res,
+            cell t1,
+            pair<string, cell> const& t2,
             inherited_attributes* st
         ) const {
             if (!t2.first.empty()) {
                 atom_t o = st->get_atom(t2.first);
-                vector<term*> a {t1, t2.second};
+                array<cell, 2> const a {{t1, t2.second}};
                 *res = st->prog.new_compound(o, a);
             } else {
                 *res = t1;
@@ -391,8 +976,8 @@ template <typename Base> struct logic_parser {
     static struct return_head_t {
         constexpr return_head_t() {}
         void operator() (
-            compound** res,
-            compound* str,  
+            cell* res,
+            cell str,  
             inherited_attributes* st
         ) const {
             *res = str;
@@ -403,8 +988,8 @@ template <typename Base> struct logic_parser {
     static struct return_goal_t {
         constexpr return_goal_t() {}
         void operator() (
-            vector<compound*>* res,
-            compound* impl,
+            vector<cell>* res,
+            cell impl,
             inherited_attributes*
         ) const {
             res->push_back(impl);
@@ -415,35 +1000,30 @@ template <typename Base> struct logic_parser {
         constexpr return_clause_t() {}
         void operator() (
             void* res,
-            compound* head,
-            vector<compound*>& impl,
+            cell head,
+            vector<cell>& impl,
             inherited_attributes* st
         ) const {
-            st->prog.db.emplace(head->functor,
-                st->prog.new_clause(head, impl, st->repeated_in_goal));
-            st->variables.clear();
-            st->repeated.clear();
-            st->repeated_in_goal.clear();
+            st->prog.db.insert(st->prog.heap(), st->prog.new_clause(head, impl, st->repeated_in_goal));
+            st->clear_clause();
         }
     } constexpr return_clause {};
 
     static struct return_goals_t {
         constexpr return_goals_t() {}
         void operator() (program* res,
-            vector<compound*>& impl,
+            vector<cell>& impl,
             inherited_attributes* st
         ) const {
-            vector<term*> vars;
-            for (auto v : st->variables) {
-                vars.push_back(v.second);
+            vector<cell> vars;
+            for (atom_t const n : st->bound) {
+                vars.push_back(st->variables[n]);
             }
 
             atom_t n = st->get_atom("goal");
             st->prog.goals.emplace_back(st->prog.new_clause(
-                st->prog.new_compound(n, vars), impl, set<variable*> {}));
-            st->variables.clear();
-            st->repeated.clear();
-            st->repeated_in_goal.clear();
+                st->prog.new_compound(n, vars), impl, vector<cell> {}));
+            st->clear_clause();
         }
     } constexpr return_goals {};
 
@@ -482,21 +1062,21 @@ template <typename Base> struct logic_parser {
     // higher order parsers.
 
     // parse atom and list of arguments.
-    static pshand<compound*> recursive_struct(pshand<term*> const& t) {
+    static pshand<cell> recursive_struct(pshand<cell> const& t) {
         return define("struct", all(return_struct, atom,
             option(discard(open_tok) && sep_by(all(return_args, t),
             sep_tok) && discard(close_tok))));
     }
 
     // parse a term that is either a variable or an atom/struct
-    static pshand<term*> recursive_term(pshand<term*> const& t) {
+    static pshand<cell> recursive_term(pshand<cell> const& t) {
         return define("term", any(return_term, var, recursive_struct(t)));
     }
 
-    // parse a term, followed by optional operator and term.
-    static pshand<term*> recursive_oper(pshand<term*> const& t) {
-        return all(return_op_exp_exp, recursive_term(t),
-            option(all(return_oper_term, attempt(oper), t)));
+    // parse terms separated by operators, which all have the same precedence
+    // and associate to the right.
+    static pshand<cell> recursive_oper(pshand<cell> const& t) {
+        return operators(recursive_term(t), infix_right(0, oper, return_op_term));
     }
 
     //------------------------------------------------------------------------
@@ -522,6 +1102,248 @@ template <typename Base> struct logic_parser {
         parser(i, r, &prog, &st);
         return i - r.first;
     }
+
+    //------------------------------------------------------------------------
+    // Snapshot
+    //
+    // A parsed program can be saved as a binary image and loaded by mapping
+    // it, using its cells, clauses and atom names in place. The image is a
+    // header, then the atom names (NUL terminated), their offsets, the cells,
+    // the clauses in database order and the goals. Each section is 8 byte
+    // aligned and found by its offset from the start, so the image is position
+    // independent. Loading rebuilds only the atom hash table and the clause
+    // index, in time linear in the atoms and clauses, and allocates nothing
+    // per term. The header records the size and hash of the source, so a
+    // stale image is not loaded. Images are in native byte order; one with a
+    // different version or byte order is rejected.
+
+    enum {snapshot_version = 1};
+
+    struct snapshot_header {
+        char magic[8];
+        uint32_t version;
+        uint32_t cell_size;
+        uint64_t byte_order;
+        uint64_t size;
+        uint64_t source_size;
+        uint64_t source_hash;
+        uint64_t atoms;
+        uint64_t text_offset;
+        uint64_t names_offset;
+        uint64_t cells;
+        uint64_t cells_offset;
+        uint64_t clauses;
+        uint64_t clauses_offset;
+        uint64_t goals;
+        uint64_t goals_offset;
+    };
+
+    static char const* snapshot_magic() {
+        return "LPSNAP\r\n";
+    }
+
+    static uint64_t snapshot_byte_order() {
+        return 0x0102030405060708ull;
+    }
+
+    // hashes eight bytes a step, so checking a source runs near memory speed.
+    static uint64_t snapshot_hash(char const* s, size_t n) {
+        uint64_t h = 0x9e3779b97f4a7c15ull ^ n;
+        for (; n >= 8; s += 8, n -= 8) {
+            uint64_t w;
+            memcpy(&w, s, 8);
+            h = (h ^ w) * 0xbf58476d1ce4e5b9ull;
+            h ^= h >> 29;
+        }
+        uint64_t w = 0;
+        memcpy(&w, s, n);
+        h = (h ^ w) * 0x94d049bb133111ebull;
+        return h ^ (h >> 31);
+    }
+
+    static uint64_t source_hash(char const* source, uint64_t& size) {
+        mapped_file const m(source);
+        size = m.size();
+        return snapshot_hash(m.data(), m.size());
+    }
+
+    // Appends clause records with their padding zeroed, so an image holds no
+    // stale heap bytes and the same program always writes the same image.
+    template <typename Iterator>
+    static void append_records(vector<char>& out, Iterator f, Iterator const l) {
+        for (; f != l; ++f) {
+            size_t const at = out.size();
+            out.resize(at + sizeof(clause), 0);
+            char* const r = out.data() + at;
+            memcpy(r + offsetof(clause, head), &f->head, sizeof(f->head));
+            memcpy(r + offsetof(clause, body), &f->body, sizeof(f->body));
+            memcpy(r + offsetof(clause, goals), &f->goals, sizeof(f->goals));
+            memcpy(r + offsetof(clause, reps), &f->reps, sizeof(f->reps));
+        }
+    }
+
+    // Writes 'prog', parsed from 'source', to 'image'. The image is written
+    // beside it and renamed, so a reader never sees a partial image.
+    static void save_snapshot(program const& prog, char const* source, char const* image) {
+        snapshot_header h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, snapshot_magic(), sizeof(h.magic));
+        h.version = snapshot_version;
+        h.cell_size = sizeof(cell);
+        h.byte_order = snapshot_byte_order();
+        h.source_hash = source_hash(source, h.source_size);
+
+        string const tmp = string(image) + ".tmp";
+        ofstream out(tmp, ios_base::out | ios_base::binary | ios_base::trunc);
+        if (!out.is_open()) {
+            throw runtime_error("unable to write snapshot");
+        }
+        uint64_t at = 0;
+        auto const section = [&out, &at] (void const* data, size_t const n) {
+            uint64_t const offset = at;
+            out.write(static_cast<char const*>(data), n);
+            static char const zeros[8] = {};
+            size_t const pad = (8 - n % 8) % 8;
+            out.write(zeros, pad);
+            at += n + pad;
+            return offset;
+        };
+        section(&h, sizeof(h));
+
+        string text;
+        vector<uint64_t> names;
+        for (atom_t a = 0; a < prog.atoms.size(); ++a) {
+            names.push_back(text.size());
+            text.append(prog.atoms.name(a)).push_back('\0');
+        }
+        names.push_back(text.size());
+        h.atoms = prog.atoms.size();
+        h.text_offset = section(text.data(), text.size());
+        h.names_offset = section(names.data(), names.size() * sizeof(uint64_t));
+
+        h.cells = prog.cell_count();
+        h.cells_offset = section(prog.heap(), h.cells * sizeof(cell));
+
+        vector<char> records;
+        records.reserve(prog.db.size() * sizeof(clause));
+        for (auto const& p : prog.db.predicates()) {
+            append_records(records, p.clauses.begin(), p.clauses.end());
+        }
+        h.clauses = prog.db.size();
+        h.clauses_offset = section(records.data(), records.size());
+        records.clear();
+        append_records(records, prog.goals.begin(), prog.goals.end());
+        h.goals = prog.goals.size();
+        h.goals_offset = section(records.data(), records.size());
+
+        h.size = at;
+        out.seekp(0);
+        out.write(reinterpret_cast<char const*>(&h), sizeof(h));
+        out.close();
+        if (out.fail() || rename(tmp.c_str(), image) != 0) {
+            remove(tmp.c_str());
+            throw runtime_error("unable to write snapshot");
+        }
+    }
+
+    // Whether 'c', in a heap of 'n' cells, refers only to cells in the heap
+    // and atoms below 'atoms'. A compound must refer to a functor cell whose
+    // arguments are in the heap.
+    static bool valid_cell(cell const* const cells, uint64_t const n, uint64_t const atoms, cell const c) {
+        switch (c.tag()) {
+            case cell::ref:
+                return c.index() < n && c.atom() < atoms;
+            case cell::str:
+                return c.index() < n && cells[c.index()].tag() == cell::fun
+                    && cells[c.index()].arity() < n - c.index();
+            default:
+                return c.atom() < atoms;
+        }
+    }
+
+    // Loads 'image' into the empty 'prog', if it is a snapshot of 'source'
+    // as it is now. Returns false, leaving 'prog' empty, if the image or the
+    // source is missing, the image is stale, or not a valid snapshot for this
+    // build. Every cell and
+    // clause is checked before it is used, so a corrupt image is rejected.
+    static bool load_snapshot(program& prog, char const* source, char const* image) {
+        shared_ptr<mapped_file> m;
+        try {
+            m = make_shared<mapped_file>(image, MADV_NORMAL);
+        } catch (runtime_error const&) {
+            return false;
+        }
+        snapshot_header h;
+        if (m->size() < sizeof(h)) {
+            return false;
+        }
+        memcpy(&h, m->data(), sizeof(h));
+        auto const fits = [&h] (uint64_t const offset, uint64_t const n, size_t const each) {
+            return offset % 8 == 0 && offset <= h.size && n <= (h.size - offset) / each;
+        };
+        if (memcmp(h.magic, snapshot_magic(), sizeof(h.magic)) != 0
+            || h.version != snapshot_version || h.cell_size != sizeof(cell)
+            || h.byte_order != snapshot_byte_order() || h.size != m->size()
+            || !fits(h.names_offset, h.atoms + 1, sizeof(uint64_t))
+            || !fits(h.cells_offset, h.cells, sizeof(cell))
+            || !fits(h.clauses_offset, h.clauses, sizeof(clause))
+            || !fits(h.goals_offset, h.goals, sizeof(clause))) {
+            return false;
+        }
+        uint64_t size;
+        try {
+            if (source_hash(source, size) != h.source_hash || size != h.source_size) {
+                return false;
+            }
+        } catch (runtime_error const&) {
+            return false;
+        }
+
+        char const* const base = m->data();
+        uint64_t const* const names = reinterpret_cast<uint64_t const*>(base + h.names_offset);
+        cell const* const cells = reinterpret_cast<cell const*>(base + h.cells_offset);
+        clause const* const clauses = reinterpret_cast<clause const*>(base + h.clauses_offset);
+        clause const* const goals = reinterpret_cast<clause const*>(base + h.goals_offset);
+        for (uint64_t at = 0; at < h.cells; ++at) {
+            if (!valid_cell(cells, h.cells, h.atoms, cells[at])
+                || (cells[at].tag() == cell::fun && cells[at].arity() >= h.cells - at)) {
+                return false;
+            }
+        }
+        auto const valid = [&h, cells] (clause const& c) {
+            if (!valid_cell(cells, h.cells, h.atoms, c.head)
+                || (c.head.tag() != cell::str && c.head.tag() != cell::con)
+                || c.body > h.cells || uint64_t(c.goals) + c.reps > h.cells - c.body) {
+                return false;
+            }
+            cell_range const gs(cells + c.body, c.goals);
+            cell_range const rs(cells + c.body + c.goals, c.reps);
+            return all_of(gs.begin(), gs.end(), [] (cell const g) {
+                    return g.tag() == cell::str || g.tag() == cell::con;
+                }) && all_of(rs.begin(), rs.end(), [] (cell const v) {
+                    return v.tag() == cell::ref;
+                });
+        };
+        if (h.text_offset > h.names_offset || names[h.atoms] > h.names_offset - h.text_offset
+            || !all_of(clauses, clauses + h.clauses, valid)
+            || !all_of(goals, goals + h.goals, valid)) {
+            return false;
+        }
+        char const* const text = base + h.text_offset;
+        for (atom_t a = 0; a < h.atoms; ++a) {
+            if (names[a + 1] <= names[a] || text[names[a + 1] - 1] != '\0'
+                || prog.atoms.adopt(text + names[a], names[a + 1] - names[a] - 1) != a) {
+                prog.atoms.clear();
+                return false;
+            }
+        }
+        prog.adopt_cells(move(m), cells, h.cells);
+        for (uint64_t c = 0; c < h.clauses; ++c) {
+            prog.db.insert(cells, clauses[c]);
+        }
+        prog.goals.assign(goals, goals + h.goals);
+        return true;
+    }
 };
 
 template <typename T> constexpr typename logic_parser<T>::atom_tok_type logic_parser<T>::atom_tok;
@@ -536,4 +1358,16 @@ template <typename T> constexpr typename logic_parser<T>::comment_tok_type logic
 template <typename T> constexpr typename logic_parser<T>::var_type logic_parser<T>::var;
 template <typename T> constexpr typename logic_parser<T>::atom_type logic_parser<T>::atom;
 template <typename T> constexpr typename logic_parser<T>::oper_type logic_parser<T>::oper;
+template <typename T> constexpr typename logic_parser<T>::return_variable_t logic_parser<T>::return_variable;
+template <typename T> constexpr typename logic_parser<T>::return_args_t logic_parser<T>::return_args;
+template <typename T> constexpr typename logic_parser<T>::return_struct_t logic_parser<T>::return_struct;
+template <typename T> constexpr typename logic_parser<T>::return_term_t logic_parser<T>::return_term;
+template <typename T> constexpr typename logic_parser<T>::return_op_term_t logic_parser<T>::return_op_term;
+template <typename T> constexpr typename logic_parser<T>::return_op_var_exp_t logic_parser<T>::return_op_var_exp;
+template <typename T> constexpr typename logic_parser<T>::return_oper_term_t logic_parser<T>::return_oper_term;
+template <typename T> constexpr typename logic_parser<T>::return_op_stc_exp_t logic_parser<T>::return_op_stc_exp;
+template <typename T> constexpr typename logic_parser<T>::return_head_t logic_parser<T>::return_head;
+template <typename T> constexpr typename logic_parser<T>::return_goal_t logic_parser<T>::return_goal;
+template <typename T> constexpr typename logic_parser<T>::return_clause_t logic_parser<T>::return_clause;
+template <typename T> constexpr typename logic_parser<T>::return_goals_t logic_parser<T>::return_goals;
 
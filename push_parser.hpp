@@ -0,0 +1,207 @@
+#ifndef PUSH_PARSER_HPP
+#define PUSH_PARSER_HPP
+
+#include <streambuf>
+#include <istream>
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+
+#include "parser_combinators.hpp"
+#include "stream_iterator.hpp"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+// Push Parser: parses input that arrives in chunks, such as reads from a
+// socket, without waiting for the whole message. The parser runs on its own
+// thread over a buffered stream_range, whose stream blocks when a combinator
+// needs bytes that have not arrived yet, so parsing suspends wherever it is
+// and resumes there when more input is fed. Nothing is parsed twice.
+//
+// feed() takes a copy of the chunk and returns once the parser has used all
+// the input it has, or has finished; it returns false after the parser has
+// finished. finish() ends the input, waits for the parser, rethrows anything
+// it threw and returns whether it succeeded. retained() is the input still
+// held (queued, or buffered by the range for backtracking), everything else
+// fed so far has been released.
+
+template <typename Parser> class push_parser {
+    static_assert(is_constructible<stream_range, istream&>::value,
+        "push_parser requires the buffered stream_range");
+
+public:
+    using result_type = typename Parser::result_type;
+
+private:
+    class input : public streambuf {
+        push_parser& pp;
+        string current;
+
+        bool available() {
+            lock_guard<mutex> lock(pp.m);
+            return !pp.chunks.empty();
+        }
+
+    public:
+        explicit input(push_parser& pp) : pp(pp) {}
+
+    protected:
+        // Blocks until a chunk is fed, or returns EOF once the input is finished.
+        virtual int_type underflow() override {
+            unique_lock<mutex> lock(pp.m);
+            current.clear();
+            setg(nullptr, nullptr, nullptr);
+            if (pp.chunks.empty() && !pp.closed) {
+                pp.waiting = true;
+                pp.cv.notify_all();
+                pp.cv.wait(lock, [this] {return !pp.chunks.empty() || pp.closed;});
+            }
+            if (pp.chunks.empty()) {
+                return traits_type::eof();
+            }
+            current.swap(pp.chunks.front());
+            pp.chunks.pop_front();
+            pp.queued -= current.size();
+            setg(&current[0], &current[0], &current[0] + current.size());
+            return traits_type::to_int_type(current[0]);
+        }
+
+        // Returns what has been fed so far rather than waiting to fill 's'.
+        virtual streamsize xsgetn(char_type* s, streamsize n) override {
+            streamsize got = 0;
+            while (got < n) {
+                if (gptr() == egptr()) {
+                    if (got > 0 && !available()) {
+                        break;
+                    }
+                    if (traits_type::eq_int_type(underflow(), traits_type::eof())) {
+                        break;
+                    }
+                }
+                streamsize const k = min<streamsize>(n - got, egptr() - gptr());
+                copy(gptr(), gptr() + k, s + got);
+                gbump(static_cast<int>(k));
+                got += k;
+            }
+            return got;
+        }
+    };
+
+    Parser const p;
+
+    mutex m;
+    condition_variable cv;
+    deque<string> chunks;
+    size_t queued;
+    bool closed;
+    bool waiting;
+    bool done;
+    stream_range const* range;
+
+    result_type value;
+    bool success;
+    streamoff parsed;
+    exception_ptr error;
+
+    input in;
+    thread worker;
+
+    void run() {
+        try {
+            istream s(&in);
+            stream_range r(s);
+            {
+                lock_guard<mutex> lock(m);
+                range = &r;
+            }
+            stream_range::iterator i = r.first;
+            success = p(i, r, &value);
+            parsed = i - r.first;
+            lock_guard<mutex> lock(m);
+            range = nullptr;
+            done = true;
+        } catch (...) {
+            error = current_exception();
+            lock_guard<mutex> lock(m);
+            range = nullptr;
+            done = true;
+        }
+        cv.notify_all();
+    }
+
+public:
+    push_parser(push_parser const&) = delete;
+
+    explicit push_parser(Parser const& q) : p(q), queued(0), closed(false), waiting(false), done(false),
+        range(nullptr), value(), success(false), parsed(0), in(*this), worker(&push_parser::run, this) {}
+
+    ~push_parser() {
+        {
+            lock_guard<mutex> lock(m);
+            closed = true;
+        }
+        cv.notify_all();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    bool feed(string chunk) {
+        unique_lock<mutex> lock(m);
+        if (closed) {
+            throw runtime_error("push_parser fed after finish");
+        }
+        if (done) {
+            return false;
+        }
+        if (!chunk.empty()) {
+            queued += chunk.size();
+            chunks.push_back(move(chunk));
+            waiting = false;
+            cv.notify_all();
+            cv.wait(lock, [this] {return waiting || done;});
+        }
+        return !done;
+    }
+
+    bool feed(char const* data, size_t n) {
+        return feed(string(data, n));
+    }
+
+    bool finish() {
+        {
+            lock_guard<mutex> lock(m);
+            closed = true;
+        }
+        cv.notify_all();
+        if (worker.joinable()) {
+            worker.join();
+        }
+        if (error) {
+            rethrow_exception(error);
+        }
+        return success;
+    }
+
+    // Valid after finish().
+    result_type& result() {
+        return value;
+    }
+
+    streamoff consumed() const {
+        return parsed;
+    }
+
+    // Only meaningful between calls, while the parser is waiting for input.
+    size_t retained() {
+        lock_guard<mutex> lock(m);
+        return queued + ((range != nullptr && waiting) ? range->retained() : 0);
+    }
+};
+
+#endif // PUSH_PARSER_HPP
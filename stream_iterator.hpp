@@ -24,39 +24,195 @@ public:
     stream_range(string const& name) : stream_range(name.c_str()) {}
 };
 
+#elif defined(USE_MEMORY)
+
+#include <fstream>
+#include "memory_range.hpp"
+
+// Reads the whole file into memory and parses it as a memory_range.
+
+class file_contents {
+protected:
+    string text;
+
+    explicit file_contents(char const* name) {
+        ifstream file(name, ios_base::in | ios_base::binary);
+        if (!file.is_open()) {
+            throw runtime_error("unable to open file");
+        }
+        file.seekg(0, ios_base::end);
+        text.resize(file.tellg());
+        file.seekg(0, ios_base::beg);
+        file.read(&text[0], text.size());
+    }
+};
+
+class stream_range : private file_contents, public memory_range {
+public:
+    stream_range(stream_range const&) = delete;
+
+    stream_range(char const* name) : file_contents(name), memory_range(text) {}
+    stream_range(string const& name) : stream_range(name.c_str()) {}
+};
+
 #else // USE_MMAP
 
 #include <streambuf>
+#include <istream>
 #include <fstream>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <iterator>
+
+// Reads the stream into a growable ring buffer, so moving an iterator back
+// never seeks. Input before the start of the outermost live backtrack frame
+// (see backtrack_window) cannot be read again by the parser, so it is
+// discarded when the buffer needs space, and the buffer only grows when the
+// frame holds most of it. 'last' compares equal to any iterator at the end of
+// the input. Nothing seeks while parsing, so pipes and stdin work. Discarded
+// input is re-read from seekable streams on error paths only, and the lines it
+// contained are still counted for error locations.
 
 class stream_range {
+    static size_t const initial_capacity = 1 << 16;
+    static size_t const reread_size = 1 << 12;
+    static streamoff const sentinel = numeric_limits<streamoff>::max();
+
     fstream file;
     streambuf *rd;
-    streamoff pos;
+    streamoff origin;
+    bool seekable;
+
+    vector<char> buf;
+    size_t mask;
+    streamoff base;
+    streamoff end;
+    bool eof;
+
+    int lines;
+    streamoff line_base;
+
+    vector<char> side;
+    streamoff side_base;
+    streamoff side_end;
+
+    size_t capacity() const {
+        return buf.size();
+    }
+
+    char at(streamoff const pos) const {
+        return buf[static_cast<size_t>(pos) & mask];
+    }
+
+    // Drop input before 'low', counting the lines it contained.
+    void discard(streamoff const low) {
+        while (base < low) {
+            size_t const i = static_cast<size_t>(base) & mask;
+            size_t const n = min(static_cast<size_t>(low - base), capacity() - i);
+            char const* const f = &buf[i];
+            lines += count(f, f + n, '\n');
+            reverse_iterator<char const*> const nl = find(reverse_iterator<char const*>(f + n),
+                reverse_iterator<char const*>(f), '\n');
+            if (nl.base() != f) {
+                line_base = base + (nl.base() - f);
+            }
+            base += n;
+        }
+    }
+
+    void grow() {
+        vector<char> b(2 * capacity());
+        size_t const m = b.size() - 1;
+        for (streamoff p = base; p < end; ++p) {
+            b[static_cast<size_t>(p) & m] = at(p);
+        }
+        buf.swap(b);
+        mask = m;
+    }
+
+    // Read more input, returns false at the end of the stream.
+    bool fill() {
+        if (eof) {
+            return false;
+        }
+        if (capacity() - (end - base) < capacity() / 4) {
+            backtrack_window const& w = backtrack_window::current();
+            discard((w.depth == 0) ? end : max(base, min<streamoff>(w.floor, end)));
+            if (capacity() - (end - base) < capacity() / 4) {
+                grow();
+            }
+        }
+        size_t const i = static_cast<size_t>(end) & mask;
+        size_t const space = min(capacity() - static_cast<size_t>(end - base), capacity() - i);
+        streamsize const n = rd->sgetn(&buf[i], space);
+        if (n <= 0) {
+            eof = true;
+            return false;
+        }
+        end += n;
+        return true;
+    }
+
+    // Symbol at 'pos' when it is not in the buffer.
+    int get(streamoff const pos) {
+        if (pos >= end) {
+            while (pos >= end) {
+                if (!fill()) {
+                    return EOF;
+                }
+            }
+            return static_cast<unsigned char>(at(pos));
+        }
+        if (!seekable) {
+            return EOF;
+        }
+        if (pos < side_base || pos >= side_end) {
+            side_base = pos - pos % static_cast<streamoff>(reread_size);
+            side_end = side_base;
+            if (rd->pubseekpos(origin + side_base, ios_base::in) != streamoff(-1)) {
+                streamsize const n = rd->sgetn(side.data(), min<streamoff>(reread_size, base - side_base));
+                side_end = side_base + max<streamsize>(n, 0);
+            }
+            rd->pubseekpos(origin + end, ios_base::in);
+            if (pos >= side_end) {
+                return EOF;
+            }
+        }
+        return static_cast<unsigned char>(side[pos - side_base]);
+    }
 
 public:
     class iterator {
         friend class stream_range;
  
-        iterator(stream_range *r, streamoff pos) : r(r), pos(pos), sym(r->rd->sgetc()) {
-            r->pos = pos;
+        iterator(stream_range *r, streamoff pos) : r(r), pos(pos), sym(EOF) {
+            if (pos != sentinel) {
+                load();
+            }
         }
 
         stream_range *r;
         streamoff pos;
         int sym;
 
+        void load() {
+            sym = (static_cast<size_t>(pos - r->base) < static_cast<size_t>(r->end - r->base))
+                ? static_cast<unsigned char>(r->at(pos)) : r->get(pos);
+        }
+
     public:
         int operator* () const {
             return sym;
         }
 
+        // Every iterator at the end of the input is equal to 'last'.
         bool operator== (iterator const& i) const {
-            return (r == i.r) && (sym == i.sym) && (pos == i.pos);
+            return (pos == i.pos) || ((sym == EOF) && (i.sym == EOF));
         }
         
         bool operator!= (iterator const& i) const {
-            return (r != i.r) || (sym != i.sym) || (pos != i.pos);
+            return !(*this == i);
         }
 
         streamoff operator- (iterator const& i) const {
@@ -64,29 +220,14 @@ public:
         }
 
         iterator& operator++ () {
-            if (r->pos != pos) {
-                r->pos = r->rd->pubseekoff(++pos, ios_base::beg);
-                sym = r->rd->sgetc();
-            } else {
-                r->pos = ++pos;
-                sym = r->rd->snextc();
-            }
+            ++pos;
+            load();
             return *this;
         }
 
         iterator& operator-- () {
             --pos;
-            if (r->pos != pos) { 
-                r->pos = r->rd->pubseekoff(pos, ios_base::beg);
-            }
-            sym = r->rd->sgetc();
-            return *this;
-        }
-
-        iterator& operator= (iterator const& i) {
-            r = i.r;
-            pos = i.pos;
-            sym = i.sym;
+            load();
             return *this;
         }
     };
@@ -98,17 +239,50 @@ public:
 
     stream_range(stream_range const&) = delete;
 
-    stream_range(char const* name) : file(name, ios_base::in),
-        rd(file.rdbuf()), pos(0),
-        last(this, rd->pubseekoff(0, ios_base::end)),
-        first(this, rd->pubseekoff(0, ios_base::beg)
-    ) {
+    // 'origin' must be read before 'first' fills the buffer.
+    stream_range(char const* name) : file(name, ios_base::in | ios_base::binary), rd(file.rdbuf()),
+        origin(rd->pubseekoff(0, ios_base::cur, ios_base::in)), seekable(origin != streamoff(-1)),
+        buf(initial_capacity), mask(initial_capacity - 1), base(0), end(0), eof(false), lines(0), line_base(0),
+        side(reread_size), side_base(0), side_end(0), last(this, sentinel), first(this, 0)
+    {
         if (!file.is_open()) {
             throw runtime_error("unable to open file");
         }
     }
 
     stream_range(string const& name) : stream_range(name.c_str()) {}
+
+    // Parse from an open stream such as cin, starting at its current position.
+    explicit stream_range(istream& in) : rd(in.rdbuf()),
+        origin(rd->pubseekoff(0, ios_base::cur, ios_base::in)), seekable(origin != streamoff(-1)),
+        buf(initial_capacity), mask(initial_capacity - 1), base(0), end(0), eof(false), lines(0), line_base(0),
+        side(reread_size), side_base(0), side_end(0), last(this, sentinel), first(this, 0) {}
+
+    // The line containing 'i' and its start, found without reading discarded
+    // input; see parse_error.
+    pair<int, iterator> line_of(iterator const& i) const {
+        int row = lines + 1;
+        streamoff start = line_base;
+        for (streamoff p = base; p < i.pos && p < end; ++p) {
+            if (at(p) == '\n') {
+                ++row;
+                start = p + 1;
+            }
+        }
+        if (!seekable && start < base) {
+            start = base;
+        }
+        return make_pair(row, iterator(const_cast<stream_range*>(this), start));
+    }
+
+    // Bytes held in the buffer, and the capacity it has grown to.
+    size_t retained() const {
+        return static_cast<size_t>(end - base);
+    }
+
+    size_t buffer_size() const {
+        return capacity();
+    }
 };
 
 #endif // USE_MMAP
@@ -0,0 +1,1000 @@
+p7(f9, a8) :- p0(f11(f14, f12(X7), f11(X2, a12, a12)), f1).
+p6(f2(f14(a10, X0)), a15, X2) :- X2 = f3(f11(a5), X3, f5(a1)), p18(f9(_, X6)), X0 = a1.
+p27(f11(f12(X6, X2, a4), f11(X0, X5), f5), f6) :- p18(X3, a13, f13(f6(a6, _, X1), f4, a15)).
+p7(a5).
+p22(a11, X3, f9(f2(a9), _)) :- _ = f5(_, f13(a11, a4, a11)), p13.
+p4(a1, f1(f11(a9), a7, X0), f14) :- X7 = a3.
+p10(a1, a6) :- p19, p8.
+p7(f10(f13(_)), a10).
+p23(f0(f8, X2), X1, f3(f9)).
+p18(X7) :- p31(X2, f13(a13, f6(X0, X2), f6(X4))), p8(f15(f7(a6, a8))), p4(f9(X6, X1)).
+p8(f14(f12(X5, X3), a8, a11)).
+ :- p1(f6(f12(a10)), X0, f12), p1(X4).
+p16(X3, _) :- p24(f11(X0, a13, f4(a0, X5, X1)), f1(f5(X2, X1, a8)), f9(f3(X7, a12), f1(X6, X3, _))), p22(f11(f5)).
+p5 :- p7(f2(f14), a3, X3), p16, p24.
+p5.
+p25(f7(a1, _, f4(a10, X2)), f12(f6(X1), f15(a4, X2, a10)), f4(f5(a15, a13, X5), a5, f7(a1))).
+p31.
+p0 :- p17(f2), X2 = X7, p27.
+p25(f8(f13(a12, a0), f7(X6, a13), f13(a15, _, X5)), f12(a6, f9(X3, a12))) :- p30(f4(f1(a13, a15)), X6), X6 = f9(X5, f7(X0, a12, a7), f6(a7, X3)).
+p16(a9) :- X6 = a5.
+p30.
+p9(f15(f5(X1, a5)), f7, X3).
+p26 :- p7(X1, f2, f5(f12(a2, a2, a4))), p11(f6(f11(a11), a3, X4), f5(f10(a11), X0, f0(a0))), X0 = f7(f14(X3, a5)).
+p4.
+p12(f14(f6(a0, X2), f6(a11), f0)) :- p21(f8(f13(X7, X3), f5(a6, a10, X3), a4)), p27(X3, a12, f8), p14(X4, X1, f4(X7)).
+p4(f3(X7, f4(a1), X3), f0(f4(a8, _, a4), f3(a4, X6)), f0(f0(a5, a10), a13)).
+p1 :- X3 = f12.
+p12(f12).
+ :- p21, p20(f12, f3, f6(a10, X7, X3)), p4(f7, f14(f1(a9, a1), a7, X1), f11(f9(X2, a1, a12))).
+p31(f12(f0(_, X6))).
+p25(f0(f0(X2, a3), f3(X2, X2), f11)) :- p28(a4, f12(X1, f4(X0, X1), a7)), X6 = X1, p31.
+p12(a14, f9(a12, a11, a13)) :- p21(X0, f12(a8, f1(X0))), p23(a13, a14, f6(f13, f9)).
+p31.
+p21 :- p30(a0).
+p31(f11(f11), X2) :- p0, p7(a2), p16(f12(a14), a6, X3).
+p13(a8, f11(f13(a12), f8(a1)), X3).
+p26 :- p11, p2(X6), p3(f5, f4(a6, f14(X1, X6, _))).
+p11(f1(f5(a0), f14(X6, a13, X1), X1)) :- X3 = a14.
+p20(f15(f6(X4, a0, a6), f8(X3, a3), f10), f1(f5(a10), X7)).
+ :- p24(f14, f1(X4, f14(a11))), p19(f0(a3, X0, a1)).
+p17 :- p2, p7(f7(f6(a11, a6, X5), f14(X0))), p19(f9(f8(a3, X3, a3), f6), f2(X4), a15).
+ :- p17(a7, f15(f3(a11, a9)), f3).
+p11(a11, f11(X6, f13(X6)), f8(a4, a14)).
+p18.
+p14(f7(f3(a4), f15(a9, X1), a14), f5, X1).
+p26.
+p1 :- p16(X1, a11, f6(f2, f4)), p12.
+p1(f2(X6, f7(a0), a15)) :- X7 = f0, p9.
+p3 :- p24(f13(X5)).
+p27(f2, a3, f10(f15)) :- p12(f13(a11, f4(X1, a4, X6), a4), X4), X0 = f2(a13, f8, a8).
+p2 :- X2 = f2.
+p6(f6(f12(a11, _, a7), a12, f1(a8, a15, a12)), a7, f5(f2(X0, a10, a3))) :- p18(a15), X2 = f4(a8).
+p30(X6, f2(a13)).
+p6(X7, a0, a2).
+p13(f11(f10)).
+p3(f11(f11(X2), f11(a11, a8), a13)).
+p27(f10(f7(a12, a11, X3), a7, f14(a10, X3, a13))) :- p11(f14(f4(X7), f4(X6, a1), f12), f8(X4), f8(f8(_, a1, a14), f0(X5, X3), f2(_, a4, a6))), p12(f3(f10(a5, a1), f10, f15), f4(f5(X5, a4, a0)), a12), p21(f14(f0(X5), f0(a7, X0))).
+ :- p15(a13, _, f2(_, f5(X0))), p11(X4, f9(X0, a12, _)), p10.
+p19(f15(X3, f0(X1, a0, X2), f7(a3, a8))) :- p2(a12, f14), p19, p12(f12(f15(a12)), f12).
+p12(f0(f14(X0, a3, a8)), f11(f7(a1, X6), a6), X1) :- X3 = f5(f2, f13(a4), f12(a8, a14, a13)), p13(a1, a0).
+p10(f9(f12(X6, X5, X5), f12(_), f9), a8, X2) :- p4, X0 = a5.
+p0(f11(f7(X5), f14(X4, a11, a4), a1)) :- p19(f2(f7(X4), f15(a7, a12, X6), X0), f8(X0, f3(X0, X1, X2)), f15(X2, f10(a9), f14(a7, X4))).
+p8(f2(f3(X7), f12), f8(X0, a7, a14)).
+p5(f9(X7, f14(X2, a11)), f14(_, f2)) :- p13, _ = X0.
+p18(f3(_, X1), a0, f12(f6(a12, X7), f15(X7, X6, X5))) :- X7 = f5(a12, f3(a12, a4), X1), p8(f8, f13(f12(a15, a5), f14(a14, X1, X5), f13)).
+p20(X7, a8) :- p23(X6, f15), p10(f8).
+p21(a11, f4(a6, a14, a2)) :- p6(a2, X5, a1).
+p13(X7, f4(f4(a4, a10, X5))).
+p30 :- _ = a13, p17, p22(f3(f1(X0, X6))).
+p29(_, f15, f11(f3(X5), a10, f7(X7))).
+p3 :- p29(f3(f1(a1, a2, X7)), f0(f10), X6).
+p3(X6, f0).
+p14(f15, f8(X2), X3).
+p14(f2(a8, f14(a9, X3, a13))).
+p25(f12) :- X1 = _.
+ :- p22(f13, f13, f12(X4)), X4 = f9(f9(a4)).
+p30(f4(f2(X2)), f6(_), f12).
+p7(f15(f5), a15).
+ :- X4 = _, X4 = f1(f14(X6), _).
+p25(f9(f13(X6, X7, X4)), f14) :- p5(f4(f6(a7, a5, X1))), p11(a0).
+p28(f3(f15, f12, f12(a11, a4))) :- p16(f4(f7(a7, a6, a2), f6), f14(f3(a2)), X1), X4 = X2.
+p30(_, X1, f11(a3, a9, X2)) :- p15(f2(f13(X4, X1), f11(_, X3), f4), f6(f8(X6, X0), f1(a4)), f6(X2, f3(X0, X7), a2)), X6 = a11.
+p17(f8(f14(a1, X5, a10), X0), X2, a15).
+p27.
+p13(f4(f5, a15), f7(f5(a7), a10, X3)).
+p3(f5(f0(a3, X0, _))).
+p13(a3, _).
+p10(f3(a1, f10)) :- X4 = f14(a8), p7(f10(f15(_, a11), f2(X3, X7, a9))), X7 = X1.
+p24.
+p2(X7, f0).
+ :- p25(f10(f1(a14, a11)), X6, f6(f1(a9, X0), X4)), p20(f3).
+p19(f9(f4(a8), f12), _) :- p7(X1).
+p12(f4).
+p23(f4(X2, f3(a14, a13, X2)), f4).
+p13(_, f12) :- p8, p16(f12(a14, f8(X7, X2), X5)).
+p22(f5(f6(X0), a14, a4), a6, f6(f8(a10))).
+p0(f8(a12, f5(X3, X7)), f6, f13(a14, f2(X4))).
+p20(f4(X4, X6), X0, f1(f15, f8(X0, X4, X2), f2(X6, X1, a6))).
+p21(f1, X7, a5).
+p8(a1, a7).
+p25(f6(f8(X7, X7, a9))) :- p28(f15(f4(X5, a10), f2(X2, X0, a8)), a11, f9(X5, f5, a4)), p25.
+p15(f7(f15, f7(a0, X3)), a12).
+p14(f14(_)) :- p23(a12, f7(f7)), p18, p8(f12(f9, X4), f14(X7)).
+p22(f0(f2(a7, a6, a0), a7, a13), f7(a12, f8(X0, a2, _)), f15(f8(a10), f15(a14, X4, a7), f6)).
+p24 :- p14, p30(f12(a15, f9, f5(a6, _)), X4, a6).
+p25.
+p19.
+p9(a14, f13(_, f11(X7), X3), f2).
+p18 :- p21, p6.
+p2(a1, a14, f9(f5(a13, a0, X4), f8(a14, X1, X5))).
+ :- p28(f4), p7(f0(X0)), p2.
+p31 :- p10(f10(f15), f5, f5(X1, f13(X6, a6), a14)), p7(f8, a9).
+p4 :- p6(f7(X5), X7), p22(a10, f1(f12(X3))).
+p26(f12(f15(a3, a5), X7, f15), f14(f14(a8), f13(X5, a12)), a8).
+p15(a8, X0) :- p25(f11(f11(a5, a12, a8), a3, f0(X3, X3)), f1(f12(a15), f14(a5))), p13, p30.
+p22.
+p6 :- p29(f15), p22.
+p5(f3(f10, a9, f13(a12, a5, X6)), a15) :- p23(a7, f0(X0, _, f7(a11, a11))).
+p30.
+p29(f8(f7(X2, X7, X5), f10(X5, a1, a10)), f14(X1), a5).
+p4(f7(X4), f3, a8).
+p14(f11(f2(X6, a3), f11)).
+p24 :- X0 = f0(X6, f12, f15(X6, a5)), X3 = f2(a7, a6).
+p13(f13).
+ :- X2 = f5(f6, f4(a0), f10(a11)).
+p15(f15(a14), a3, f2(f15)) :- X7 = a8, p4, p20(f6(_), a0, f1(a4, f9(X3), f15(a0, a14))).
+p21(a0, f0(f11(a10), X7), f14(f6(X3, a5), f8(X5), f3(X5, X1))) :- p12(f5(f1(X2), f1), f6(a15), a13), p29, X0 = f10(f8(a2), f10).
+p16(f15(f15(a6), f5)).
+p15(f1(a11)) :- p6(X5, f12), X4 = f0(f7(a3), X3, f0(a13)).
+p30(f5) :- X5 = f8(f8, f7, f13), p21(X5), p3.
+p23(a7, f12(f2(X2, X2, a6)), f3(f14, f3, f0(X7, a5))) :- p17(f6(a14, X2), f3), X0 = f15(a9, f0(a4, _, X2)), p22(f2(f5(a0, a4, _)), a4).
+p24 :- p11, p3(f3(X5, f3)), p15(f7(X7), f10(a14, f12), X0).
+p27(f15(f11(X5, a12))).
+p14.
+p2(f9(f2(X1), f9(X0, X7)), a13, X7) :- p14(f5(X5, f5(a8), a14), a0).
+p29(f3, a10, f13(a8, f2(X3, X0))).
+p23.
+p25(f5(a3, f2(X2, a4, _)), a0).
+p29(X5, a11, X6).
+p14(f14(a7), f10).
+p6 :- p15(a4), p6(f12(f0(_, X5))), p4(f14(f9(X0, a8, a9)), X0, f0(a13)).
+p22 :- X3 = a4.
+p13 :- p31(f12(f4(X0, a6, _))), X5 = f11(f1).
+p1.
+p15(f15) :- p22(f7(f11(X7, X3), a13, f13)).
+p29(f12) :- _ = f6, p19(a4, f13(f10(a8))), X4 = a1.
+p31 :- p19, X1 = X4.
+p24 :- X5 = f14(a12).
+p20.
+p9 :- p30.
+p18(f9) :- p21(a10).
+p7(f1, f5(a6, X5, f7(X4)), f0(a6, X0, a7)).
+p0 :- p5(f0(f8(a6, a2)), f10(a14)).
+p30 :- p12(f6(f12(X2))), X6 = X0.
+p11(_, f15(f8(X2, a0, X6), a11)).
+p5(X2) :- p28, p26(f0(X6)), p1(X2).
+p21(f5(f11, f9(X0, X1, a0), a15), f6) :- p5, p10(f8(X0, a4, f14), a6).
+p24.
+p11(_, X2, f10(f3(a12, X6), f12(X5))) :- p23, p20(f11(a10), f1, f1).
+p18.
+p2.
+p22(f12) :- p13(f9(f1)), p22(f9(f7(X4, X2, a10), f12)), p7.
+p11(f6, f13(f15(a13, X2), f2(a12, X2, a5), a4)) :- X4 = X2, X4 = a9, _ = f6(f10, a9, f2(_, a11, X6)).
+p3(f12).
+p26(f1, f8(f12(X3, X2), X7), f1).
+p25(f12) :- p18(f10(f1(X2, a11, _), f0(X1, X3, a14), f7(X7))).
+p11(f8(f8(X4), a11)) :- p16, X6 = a12.
+p1.
+p12(f7(a7), a5).
+p16(a10).
+p26.
+p25 :- p8(X7), p30(f11, a4, a5).
+p15(f10(f5(a3, X5), a0, f8), f14(X6), f7(f6(a7, a14))).
+p17(f5(f0(X3, _, X2), f3(X6, a14, X7), f5(a1, X3)), f11(f13, a2), f8(f5(X4), f7)).
+p25(a15).
+p8.
+p13(X7, a8) :- X0 = f5, p29(X0).
+p18(a3, f6(a11, f8(_, a15, a8), f2(X7))) :- X0 = X5.
+p7(a12, a7, f15(f2(a15, a0, a10))).
+p0.
+p0 :- p10(X7, f10, a0), p30(f1(f11(X1, X2)), f10(f5)), p29(f11(a3, f5(X1, X0), f14)).
+p14 :- p30(f3, a13, X6), X1 = f12(f11(a15, a0), a1, f9).
+ :- X5 = f0(f4(a1, X7, X3), a11, f15(X5)).
+p24.
+p14(f14(f9(a0, X4, X7)), f14(X7, X3)).
+p22(f2).
+p12.
+p15(f8(X3, f5, f1(X2, X6))).
+p14(X0, X6).
+p28(f12).
+p0(a3, f5(X1), f0) :- p1(a11), X3 = X4, p25.
+p10 :- p4(f3(a14, X0), f8(a0)), X3 = f12(f7(a10)), X7 = f1(f13, X2, f1).
+p26(a8) :- p18(X4, f4(X7)), p7(f14, f2(a13, f9(X6, X6, a12))), p11(f1(f8(a6, a10, X1), a2, f6(X6)), f0, a3).
+p3.
+p11(f1(a6, a10), f14, f11(f13(a6), f3(X0, a3, X6))).
+p9(f1(X5, f6(_, X6)), f1(f4, a0, X2)) :- p10(f0(f2(_, a4)), f8), p14, p20(f9(a0, f15(X6, a14), f6(a8, X2, a12)), a15, f10(f11(X3, X1), f2(X3), X1)).
+p16(f15(X7, f14(X7), f9(a8, X5)), a7).
+p23(f3(f13(a9, X4, X1), f10(X5))) :- p17(f4(f5(X5, a10), a6)), p31(f3, f9(f3(X3, X3, a13), f10(a14, a8), X2)).
+p31(a10, a13) :- X7 = f4(_), p12.
+p22(f11, f2, f14(f15(a13, a12, X6), f4(X2))).
+ :- p0(f0(f5(a15, a15, X2))).
+p2 :- p10(X6, f12(f6(a12, a4, a13), f1(X1, a7, X5))), X3 = a15.
+p12.
+p26 :- p31(f1(f2(a12, a6, X5), f10(a2)), X7, a8), p14(f0(f9, f4(a14, X2))), p0(a3, f10(X0, f2(X0, a5))).
+p11(f14(f1(X2, a12), X0)) :- X0 = f5.
+p4(f14(f1(X3, _, _), a4)).
+p11(f7(X1, a8, f15(a8))) :- p14, p9(f15(a6, f10(a11, X6, X3)), f2).
+p4 :- p12(f15, f13(a8), f9(a14)), X4 = f5.
+p10(f13).
+p20(X0) :- p0(f2(f11(X0, a1), f2, f5(a13, a11, X1))), p13(f2), X1 = f14(a10, f10(X3, a12, X7)).
+p1(a0, f14(f15(X3, _, X1), f9(a5, X5, X0))) :- p5(a4, f15(f14(a1)), X6), p10.
+p23.
+p17(f4(f13(X0), f15, a2), X1) :- p25, X0 = f6.
+p19(f15(f8(X6, a9)), a12, _).
+p6(f9(f1, f8(a10))).
+p9(X2).
+p7 :- X3 = f7, p5(X5, a11), p0.
+p12(X4, f14(a12, X6), X1).
+p6(f5(f3, f12(a2)), f5(f2, f15(a1, a12))) :- p25(f6, f4(a1, f15(_))), p11.
+p10(f2(X7, f5(a5, _, a0)), a12) :- X7 = a4, p22(a13, f0(a15, a5)).
+p27(f11(f13(X3, X4)), f7(f14(X2, X4)), f12(a7)) :- p3(X2, f12(f9)).
+p9(f12(a1)) :- p9(f14(f11(_)), f5(f6(X4, a0)), f2).
+p11(f5(f3(a13, a12), f10, f0(a5, a11)), f12(a8), f8) :- p8(f10(f8(a5, a6), f14(X0, a4), X7), f9(f6(a11), a0)).
+p4(f8(f4, X3), f11(f8), a11) :- p29.
+p24(f4, f6(_, f6(a2), f3(_, a3))).
+p25(f12(f7(a0, a7, a15)), f13(X6), f8(f6(a14), f9(X7, _, a5))) :- p6(a2).
+p17.
+p18(f15(a11, f1(a4, a4), f3(a2, a1, a14)), f10(f13(a8, a6, X7))) :- p19(X0, f4), p28(X6).
+p23 :- p7(f12(f8(X0, X5, a2)), f0(X2, X4)), X7 = a1, X6 = X4.
+p0(f2(f15, f7(_)), X3, f2(a0)) :- p17(f7(f12), f11(f7, f8(X7, _, X5), f7(a0))), p6(f12(f2(a13, X7), a11), X5, f8(a9)), p24(X5, X4, f0(f14(X5))).
+ :- p9(a1).
+p11.
+p4(X7, f13(f7(X2)), f4(f10(a9), f3, f8(X5, X1))).
+p19(f1(f12)).
+p18.
+p11(f9(X3, f2(a13, X3), X3)) :- _ = f3(f10(X3, _, X6), f15(X4, X7)).
+p2(f10(f10(a3, X6))) :- _ = f10(f10(X0, X7)), p22(f3, X4, a7).
+p2.
+p10.
+p19.
+p4(f5) :- X2 = f3, p25(f9(a13, f15(X0, X5, a4)), f4(f11(X6, a6)), X7).
+p20 :- p1.
+p10(f10).
+p6 :- p13(f13(f3(a7, a9, a1), a10)), p28(f15).
+p26 :- p14(f0(f11(X1, X4), a13)).
+ :- p6(f1(f0, f2(a13, a0), f8(a2))).
+p11.
+p20(a12).
+ :- p5(f0, X1).
+p21(f1(X5, a14), f3(f11(a10), f14(a5), f5(X3))) :- p11, p22.
+p27(f11(a15, f7(_)), f7).
+p24.
+p19(f8(f2(a2, X7, a15), f10(a3, a9))) :- p8(f1(f6, f12(a4), f0)), p18(a9, f13(f9(a3), f3)), X6 = a6.
+p24(f2, X3, _).
+p26(f15(a3, f15(_), f10(a13, X3, a5)), f1(f5(a0), f13)) :- p5(X1, f6(f11(a15, X5, a0), X5, f12(a15))), _ = f9.
+p10(X4).
+p4(a6, a0, _).
+p25(f9).
+p15(f2, X3) :- p15(f4, f12(f8(X1, X5, a0)), f12(f10, X6)), p23(f3, a2, f13(a11, a6, f11(a14, a13))), X5 = f0(f7(X4, a12, a12), f12(X7, X5, X0), f5(X5)).
+p6(f10).
+p26.
+p24.
+p27.
+p11(f6(f10, f6(X7)), f15(f8(X6, a13, a14), f8, f7(a0))).
+p0(X3, f2).
+p7(X3, f13, a15).
+p4 :- p4, p14(f5).
+ :- p31(a8), p28(X5, f0(f3(X2, X4)), f0(a6, f12(a8), f10)).
+p14(f15(f5)) :- p0(f4, f10), p9(f13(f0, a7)).
+p27(f4(f9(a8, a0, X6)), f5(f15(X4, X7, X7), X7)).
+p21(f11, f10(X7, f14(X7, X7, X5), f0(_, X5, X2))) :- p1(f4(a5, X2, f6), a13, f4(f2, a2, f2(a7, X1, X3))), _ = f11(f6, f4(a7, a15, X5)).
+p0(f5(a4, a10, f10(X6)), f1(a0), f2(f2(X3, X4, a0), f9(X5, a5, a8))) :- p21.
+p14(a8, f14(f15(a15, X1), f0(X6, a9)), f11(f15(X4, X0), f13)).
+ :- p12(f0(f12(a1, a9, X5), f9, f13(a5, X0, X3)), f9), _ = a13.
+p23(f14(_, a13, f14(a9, a1))) :- _ = f15(f7(X6, a0)), p10, p3(f2).
+p19(f9, X2, X2) :- p14(a15), p26.
+p20.
+p25 :- p1, X1 = f11(f4, f15).
+p20(f5(f10), a11).
+p24(_).
+p25(f10(f0(a11, X0))) :- p20(X3, f7(f13(X7, a6), f9(a12, a14, a15)), f1).
+p29(f11).
+p21(f13(X0, f15), f12(f1, a8, f7(X0, X6)), a11).
+p14(f11(_, f6(a9, a8), X5), X0, f12(f15(X3, X5))) :- X1 = f7(f10(X4), f3(X2), f1(a6, X7, a13)).
+p13(f11(X6, f2(X5)), f13(f8(a11, X1))).
+p16(X6, f10(f2(X4, X0, X3), X2, f12(a0))) :- p2(f7(a7, f1(X7, X4), f15(a1, _, X2))), p10, p0.
+p17(a10, f13).
+p13(f10(f2(a15), f10(a12, a11))) :- p22(f0(a13, X1, _), f1(f14, f3(a15, a10, X6), a1), f7(X5, f10(a12, a13), f11(X5, a13, X5))), p30(a5, f10(f1, f5(a12), f11(a4))).
+ :- p20(f8, a12, a10).
+p31(X6, X4, a8).
+p28(f6(a5), X3, X3).
+p18(f1(f3, a9, a5), X3).
+p2(f7(f11(a7), f7(a15), f6(a1, X0)), f13(f7(a11), f5(X4, X4, a7))) :- p24(X3, f15(f8(a11, a1))), p3(f10(a4), a3, X2), X5 = _.
+p10(a11, X6) :- p4(X7), p22(X6).
+p26(f1(f4), f9(f10, f0, f10(X3, X6, a3))).
+p0(a10) :- p18(f10(f0(a5, X2), f3(a14, a10), f4)), p23(a12, a12, f9(X3, a6)).
+p22(f6(a6, f13(a13, X6), f7(_, a2, a15)), f10(f3, a2), f12(f13(a5, X2, a13), f8(a1, X7, a13), f14(a15, a8, X5))) :- p0(f2(f3, a15, f11(X4, X7))), p30(f3(f12, f14(X2, _)), f6(a8, f2(X2, a9))).
+p6(f12, a14, a1).
+p16(X7, a0, f2(a1, f14(X3, a4, a7))).
+ :- p25(f7(f1), f12(f2(X2, _)), f2(f15(a7, a11), _, f3)).
+p15 :- X1 = _.
+p11 :- p19(f6(f5, f6(_)), f11(f3(a10), f4(X5, a7)), f1(f6(a9, X2))), p20.
+p20(a11, a14).
+p2(X2) :- X4 = f2(X1), p27(f8(f9(a13, a13)), f3).
+p21(a4, f1(X1), X4) :- p22(f15(f11(a9, a10, a10), f14(a11))), p19.
+p6(f5, f5(f12(X1, X3), a13, a6), f1(X3)).
+p22(a1, X6).
+p23(X2).
+p3(f11(f9(a15)), f15(f2(a4, a15), f1(X7))) :- X2 = f9(f12(X1)).
+p19.
+p0 :- X7 = f6(a8, f6(a3, _), a12), p21.
+p2(a8, a9, f14(f10(X7, X1, a9), f3(a12, X0), f10(X7, X5))).
+p30(f6(f1(X1, a8), f2(X4, a6), f1), f4(f0(X3, X1, X2), f14(X7, a10, a6), f12(a8))).
+p22(f9, f3).
+p22(X6, X2) :- p9(X6, f12(f12(a15, a5, a2), X1, a8)), p2(f9(a3, f13), a6, f2(X0, f5(X2, a5, a12))), p1.
+p6 :- _ = f14, p15(f11(f7), _, f1(f14, f14(a4), f7(X1, X2))).
+p13(a6, f15(f3), a13).
+p13(f10(f8(a11, a5, X2), f13), a8) :- p2(X5, f2).
+p2(f11, X5, a12).
+p28.
+ :- p19(a10, f1, X3), X4 = f15(f4(a14, _), f10(a10, X2)), p19(a15).
+p5.
+p2.
+p24(f7(f9, X5)).
+ :- p4(f8(f6, X7, a3), X7), X5 = f11.
+p7(a5, f14(f3(X0), f14(a12, a2, a0), X7)) :- p18.
+p6(f11(f9(X4), f9(X0, X2), f12(X4)), f9, a9).
+p6(a11, f12(f12(a2, a1, a11), f5, f9(X3, a12, a3))) :- p14(X0).
+p10.
+p24.
+p23(X1, f6(f12(a5, X6, a10), f3)).
+p15 :- _ = f4(f8(X6, X5, a1), f0(X5, X6), X0).
+p24(f2(f14(X6, X5), X7), f9(f13(_))) :- p15(X6, X5, f15(f0(a5, X2, X5))), p4(f9(f6(a2, a7), f1(X3, X6), f12(a1, a6, a6)), f8(f2(a6, X1), f9), f9(f6(a4, X0, X4), X6, f6(a13, a1))), p18(f12(f6(X5, _), X1, f0(X4, _, X4))).
+p22(a0, f8(f15, f4(a4), f10), f3(f4(a15, a14))) :- p10(a3), p29(a8, X0, f7), p29(X5).
+p11(f0, f10) :- p21(f2, f9(f13(X3, X6, X7), f15(X0, X1))), p20.
+p3(a5) :- p27.
+p19(a11, f9(a1, f15(X7))).
+p13.
+p3(f15, f11(f2(X2, a6, a11), f15(a15, X7)), X0) :- p16(a2), p9.
+p14(_).
+p25(f8(f13(a15, X2, a9), _, f9(a6, a14, a7)), f4(f3(a9, _, a8)), f6(f6(a14), f5(a15, X3, a8))).
+p2(f12, f14, X0) :- p0(f13(_)).
+p20(f3(f4(X5), f0(_, X6, a1), f15(a5, a2))).
+p10(a13, X0) :- p24(f3(f2(a1), f7(X4, a11), f4(a14, X3)), f9, f5(f13(a8, a10))), X0 = f8(f0, f3, f5), X0 = f13(f6, f6(X5)).
+p16(X1) :- p5(f10(f4, f11(a7, X4, X4), f6), f9, f6(f3)).
+p22(X0, f9, a14) :- p13.
+ :- p28(f1, X0).
+p17(f6(f7(a13, a9), a3, X4)) :- p21.
+p28(f13(f12(a3))).
+p19(f6(a9, f14(a6, X7), f7)).
+p15(X3, f0(f7(X7, X2, X3), f7(_, _), a9), a5).
+p12(f15(f8(_), f2(X2, X2), X3)).
+p20(X1, a15) :- X0 = f0(f9), p26(f9(a7, f14)), p29(f11(X4), f1).
+p22.
+p16(f13(f2(a13, X3), _)) :- p6, p20(a9, f4(f12(a7, a5)), f3(f0(a15))), p11(f8(a4), X6, f9(f5(X3), X5, X3)).
+ :- X3 = f8(f11(a10), f10(X2), f0(a9)), p2(f8(f1(a11))).
+p6(f7(f12, f1), f8(f0(X0), a0), f3(a10)).
+p21(f11(f15, f4(a9, a0), f1(_))).
+p16(f15(f7, f15)).
+p8(f11(f12(a9, X5), f9(X1, X4), f8(a4)), f3) :- p15(a3).
+p7(f6(a10, f8(a9)), a13, a9) :- p12.
+p4 :- p22(f3(f8)), p29(f5(f7(a12, _), f0(a2), X0)).
+p20(f5(f9(X4, X6), f5)) :- X7 = f4(a3), p10.
+p28(X1, a14).
+p11(a3, f10(a1, f5(a11), f12(a1))).
+p20(X6) :- p21(X5, f12(X7)), _ = f2(f10(a13), X4).
+p10 :- p9(a8), X7 = a4, p0.
+p13 :- p22(f4), p26(X4, f8, f15(f8(X6, a14, a0), f7, a6)).
+p17(f12(f10(X4), f10(X4, X5), f2(X3, X3))) :- p10(f15, f1(a0, a7, f10(X7, a3))).
+p18.
+p18 :- p13.
+ :- p10, p18(a15, f0(a6)).
+p26(f10(f5(X6, X4), f13(X4, X1))) :- X7 = f15.
+p13(a15, X7).
+p7(X0).
+p2(a1, f4(a9)).
+p3(f8(f9(_, a4), f12), f4(f5, f9(a14, X0, a1), f3(X2, X1))).
+p0(_, f11(f2(X1, a11, X4))).
+p8.
+p13(f4(f12(X7), a9, X3)) :- p8(f15(f2, X1, f9), a1), p23(a15, a3), X4 = f15(_, a8).
+p11 :- X7 = f1(f4(a8, a13, X7), a5), p9(a4, f1, a9), p12(f15(f0(X0, X2, X3), X6, f13(a15, a14, a15)), f11(X2, f7(a7, a10)), f15(f11, _)).
+p21(f10(a3), a10, f8(f14, a12)) :- p23(X5, f7(_, X5)).
+p20(f11(f10(_, X1))).
+p1.
+p20(f15(f11(X5, a2, X4))).
+p28(a0).
+p21(a10, X6) :- p7(f10, f0(f8(a7), f0(a8, X0, a5), f9), f12(f2(X7, a3, X5), f3(X3, a13))).
+p15(f5(a0, f14(X4, a10))).
+ :- X7 = f10(f1(X7), f14(a12)), p30(f2, f7(f12(a10), X3)).
+p17 :- p21(f13(f9, a3, f3(a7, a10, a13))), p13.
+p4(f7(f15(X1, a7, X0), f4(X5))).
+ :- X4 = f11(f1(a6), a9, X4).
+p31 :- X4 = _, p26(f15(f4(a0, a2, _))), p14(f0(f0(a11, a3), f6(a3, a13, X5)), _).
+ :- X4 = f14(f6(X2, X5)).
+p20 :- p25(a13, f11(a14, f3(a7, _), a5), f10(f14(X0, _, a7), f10, X2)), p12.
+p25.
+p4(f13(f8(a9, a4)), f13).
+p2(f4, a8, X0) :- p18(a14), p20(X2, f8(f4(a9, a6), a7, f1(X7)), a14).
+p5(f7(f14, X6)).
+p21.
+p5 :- X3 = X3, p1, p3(f2(f1(X3, a3, X3)), f14(f7, f7(a10)), f9(f11(a0, X6, a0))).
+p10(f9(f2(X6, a14), f10(X6))) :- _ = f2(a14), p13(a0, f15(f15, a3, X7), f5), p13(f5(f11(X7, X4, a15), a12)).
+p13 :- p2(f1, f8(f3), X3), p12(X4), p26.
+p26(a8, f7(a12), f11(f3(X6), f1(X2, a7), X5)).
+p31(f10) :- p26(f0(a1), a13, f8(f12(X1, a2), f13(X0, X7))), X2 = f4, X5 = f0(f14(_, a2), f8(a12)).
+p28(f0(X6, a1), X2) :- p7(f3(X7, a6)).
+p6.
+p10(f14(f9(a10))) :- p4(f14, X2), p3(a10), p10.
+p28(f6(f11(a5, X6), f7(a12, X6, a5)), _) :- X6 = f10(f12(X6)), p2(f14(f8(X5), X3)), p15(_, f2(f14(a13, a2))).
+p31 :- p29(X0, f3(a8, f3(a14, a6, a2), f14(a11))).
+p24(f12(f0(a10), a0, X4), f1(f10(a3), f0(a0), a6)).
+p13(a14, f5(f14(_, a1, X7), f0(a6, a15, a12))) :- p24(f6(f3)), p1.
+p23(a10, f2(a7), f12).
+p12(_) :- p25(f3(f15, f4, X1), f15(f5), f11(f9, f4(X3))), X7 = f11(X5).
+p7.
+p30(f6(f1(X5), f2(a15, _), f0(_)), f3(f8), f2(f12(X5))).
+p3 :- p18(f15(f5, f8), f14(f14, a7), f6), X6 = f3(a1, f3, X6).
+ :- p17(_).
+p25(f12(X5, f2, f0), X0).
+p5(f6, f1(f1, X4), X3) :- p17(a13, f8(a8), f4(a8)).
+p6(f12(f5, f13(a0, X5, X3)), f12).
+p7(f5(f7(X3, X1, a8)), f14(f3(X3, X5, a3), f15(a0))) :- p29(f6(f6(a12), f11(a3), f10(a3, a5)), f12, f10(f12(X7), f8(a8, a4, a9), f12(a13))).
+p15(f4(f7(X3))) :- X2 = f9, X6 = f15.
+p5(f4(f13(_, X5))).
+p13(X5).
+p3 :- p12, p13(f12(a2), f13(f13(a13))).
+p10(f5(f1(X1, X1), f5(a8))) :- X3 = f0(X2), X7 = f12(f11, f14(X6), a0).
+p2(X4, f13, X4).
+p29(f5(f11(X7, a7), X0, f7)) :- p0(f10(f2(a7, X3, X7))).
+p1(a2, f14, f0(f10(X3, X6, a9), f5(X7, a7, a14), f11)).
+p8 :- p14(f6), p28(X5, a9, f10(f8(_), f9(a14), a15)).
+p22(f7(f9(a13, a2), f13(X3, a7)), f5(a9, f0(a5), X1), a0).
+p11(f14(f0(a0, X7), f7(a7, a8, _)), f6(f7, f4(a2, _, a1), a1), f1(f6(X6, a12, a15), f0(a9))).
+p26 :- p26(f2(a11)), X3 = f15(f3(X3, a15)).
+p2(X1).
+p21(f6, f4(f1(X1, X2, a15), f15(X1), f2(X2, a0, X3))).
+p1 :- p30(X5, f6, f8), X6 = f10(f7(X3, X6)), p7(X4, f5(f12(X7, X6, X7), f10(X7, X6), X6), f1(f6(a10), f6(X4, X4, a14), X4)).
+p9(f9, f2, f7(a4, X6, f4(a2, a0))).
+p22.
+p6.
+p4(f8(f14, f11), a6, X2) :- p1(f7(a3, f2(_, a5), f8(X1)), f12(a3, f3(X1, a14))), p10, p24.
+p27.
+p18(X0, f11(X0, a6, f10), X7) :- p21, p9, p23.
+p9(a7).
+p20 :- p8(f5(f6, f14(X4, X3)), a15, f4), X4 = a11, p24(f3(f4, f11, _), f14(a3, f5)).
+p27 :- X6 = f14(_), p10(f12(a14)).
+p10(f2(a9, f7)) :- p7(f3(f5, f4(X6, X3)), f6).
+p28(f4(a14, f2), f15(a7)) :- X5 = X6, p23(f2(f1, f14(a0), f12(a14)), a4, a4).
+p3(f4, f10(f11(X6, a0), X3, f7)) :- p12(f1, f0(f9, f8(a7, a11, a10))), p1(f8, X2), X0 = f1.
+p5(f0(a7, a3), f11(f0(a4, a1), f3(X7, X5, a3), f0)) :- p29(f2(f7(a7), f11(a6), a4), a8).
+p30(a12, f9(f5(a4, a10), X0, f2(X7, a10, X0))).
+p6(f6(a7), f12(f7), a10).
+p10 :- p20, p28(_), p17(f1).
+p13(a6, f7(X5, f15(X0), a3)).
+p14(f5(f9(a9, a7, X4)), f2(X0, f0(X2, a4, a10)), X2).
+p4(f8(f8(a10), X1, X0)) :- p0(f8(f8(X5, a1, X4)), f0(a5, f15, f1(a0, a5)), X4), p22.
+p13(f11(X4, f10(X5, X3, X3), a2), X3, f0).
+p16(a3, X5, f14) :- p4, X6 = f11(_).
+p23 :- X1 = f9(f14(a0), f6, f3(_)).
+p9(f15(f11), f14, f4) :- p15(a0), p24(f9(X2, f2, f0(X6, a3))), p16(f1(f14(X0), f14(a12), a9)).
+p28(f0, a3, X6).
+p26(a9, f1).
+p3(f7(f9, f14, f5(X3)), f2(f12(a12, a3))).
+p6(f7(f13(a14, a11, a10), a15), f3, f9).
+p27(X7, f3(a5, a8)) :- p25(f12(a14), f0(f6, a15, f9(X3, X6))).
+p18(f4(f2, f6)) :- p29(f8(a12, X5, f3(X3, X7, _)), f9(a3, a5), f8(a1, f9(a10, a3, a4), X2)), p10(f12(f12(X2))), X7 = f6(a6, X0, f10).
+p17(f14(f4, f1(a2)), f11(f9)).
+p28(a6, X6, f15).
+p4 :- p1.
+p13(f4, f7(X5)) :- X1 = f6(f8(X7)), p20(a1, f9(f6(X2), X6), a14), p11.
+p0(f14, f3, f15(f15, f15)).
+p28.
+p22 :- p20(f1).
+p13(f12(a15), f3(f11(X6, X0), f14), a3).
+p23(f9, f8(f2(a8), f11(a10)), f12(X4)).
+p28(a9, f10).
+p5(f6(a3, _)).
+p19(f1(a0, X0)) :- p31(f2(f1(a5, X2, a12))), p4.
+p17(f6(f15(a12)), X5) :- X5 = f3, p25(f8), p12(f9, f3(f3, f4(X6, X0, a1)), f10(f11(a15, X6))).
+ :- p9(f9(X0, f3), f3(f15(a12, X4, a2), f2, f3(X3)), f3(a9, f3(a15), f4(a9, a2))), p5(f8(f11(a7)), a1), X5 = X3.
+p11(f15(f5(X0, a4), a11, a5), f9(a12, a9), f14(f0(X1, X7), f9(X3, X3, a0), f13(X6, X3, _))).
+p17(f7, X5).
+p28(f11(X7, f10(a5, X7, a6)), f3(f8, a10, f7), f14(X3, f12(a1, X5), f15(a7))) :- p5(f1, f8).
+p15(X2).
+p16.
+p22(X4, f15).
+p2(X0) :- p29(f9, X2), p20(f5, f2), X4 = f10.
+p1(f8(a7, f4(a7, X4, _), f4(a8)), a9, f9(_)) :- p10.
+p24(a0, f8, f11(X3, _, f6)).
+p10(X1, f13(f11, f13(X4, a4))) :- p7, X4 = f12(f4, X7), p30.
+p24(f12(f14(_, X1), f15(X1), f10(_)), f11(f10, f11(X1, a12), f4), X2).
+p31(f11(f5, a2, X5), X4, a10) :- p26(a3, X6, f0).
+p3.
+p20(f14(a15), X3) :- p9(f9(f1(a13, X3), f3, f10(a1, a12, X0)), f9(f8, f3(a4, a4)), f15(a5, a9, a2)), p22.
+p22(a7, f7(X2, f10(X3, a12))).
+p10(f11(f9(_, a10), X5, X5), f6(f10(a8, X1), f2(a1)), f8(a15, f2)) :- X5 = f5(f5(a10, a9), f0(a13), f7(a11)), _ = a14, p4(f1(f10(a7, a14, a14), f14, X3), f7(a8, f11(X6, X7), f7), f14(a3, f6(a10, a9))).
+p30 :- p22, p25, X0 = X2.
+p4(X1).
+p3(a13, f10(X2, f14(a4, a2))).
+p1(X7).
+p14 :- p25(a0).
+p11(f0(f2(a0, a0), a7)).
+p2 :- p1(f9(f5(X4, a0), f4(X2, X2, a14), X0), f10), X3 = f12(f0, f3(a10), f12(X3, a11, X6)), p15.
+p29 :- X2 = f14(f1(X6, a15, X0), f7(X0, X5)).
+p22(X4, _, _) :- p2, p22(f12), p31(f15(a14, f14(a6, a3, a9), f4(X3)), f10(X2, f9, a6)).
+p30(a3).
+p15(f12(f0(X3, a3))).
+ :- p27(f2).
+p29.
+p21 :- p29.
+p28(f5(f11(a15)), f11).
+ :- X4 = X5.
+p25 :- p16(X5, X3, f4(a14)), p23, p5(f5(X5), f2(f4(a1, a5), f9(a10, a7, X4))).
+p1(f14, X1, X2) :- X7 = a1, p15.
+p0(f1(f15(a5, a10)), f1(a1), a9) :- X5 = a6.
+p14(f8(X2), f9, a1).
+p10(a2, X5).
+p25(a1, a5, f2).
+p30(f2(f9, f9(X2, a0, X2))) :- p4(a15, f1(f6(_, a15, X5), f15(X3, a10, X7), X3), f10(f1, _, f5)), p21, X7 = a8.
+p7(f4(f8, a5), X4).
+p31(_) :- p27(f0), p27, p25(f13(_, f8(a6, a13, X2)), f1(f2(a2, a10, a8)), f3(f0, a12)).
+p2(a0, f1).
+p10(a9).
+p4(f13(f4(X3, X6, _))).
+p20(a15, a13) :- p19(a4, f5(f11(a14, a0), f0), f15(a15, f13(_, a14), a11)).
+p31.
+p29 :- X0 = a4.
+p16(f10(f9(a15, a5), f10(a15, a9)), f12(f2(X3, X3)), a10).
+p22(X4, X2) :- p28.
+p0(f7(f11(X4, X5, a2), f1, f9(a4)), X0, f15(f9(X2, a13), a9)).
+p12.
+p7(X0, f13(f15(a8, a14), f13, f3)) :- _ = f13(f5, f7, X4), p24(f10, f10(f15(X7, a14), _, f7(a6)), X4).
+p11.
+p24(f15) :- p29.
+p0(f14(f2, f5(a13), f4), f7(X3, f2)) :- p6, X1 = f14.
+p0 :- p21(f13, a9), p12(a11).
+p21(f11(f8, f7(a15, X4, X5), f1(a11, X4, a13))) :- X0 = a6, X5 = f13(f4(a7, a11, X0), _), p13.
+p16(f3(f13(a7))) :- X5 = f9(f5(X2, X0, X4), f4(_, X7, X1)), p15(a11, f0(X4)).
+p12(f7(X5, f0), f8(f11(X1, X7))).
+p9(f12(f5(X7), f12(_, a4), X2), a3, X1) :- p20(f9(f0(X4, a3), f12(X4, a3, a11)), f0(X0, f8, f15(a13, a3, a0))).
+p8(f10(f7), f15(f5(X4, X5), f12(a0, X4), f8)).
+p25.
+p6(f15(f10(X4, a8, a5), X5, a9)) :- p1, X6 = f11(X2, f6(a14), f3(a14, X0, X4)), p16.
+p0(f9) :- p24.
+p24(X2, X5, f10(f9, f9(X2, X5))) :- X2 = f7(f13, f7(a14, X4, X7)), p25(f2(f8(a12, X6, a0))), p31(f11(a6, f13(X4, a12)), f9(f11(X6))).
+p27(f5(f5, f3(a11, a11), f5(X7, X4, a14))).
+p24(X2, f6(f8(a0, a3, a14), f7(a1, X5, a15), a9), f9(f4(a0, X5, X2), f7(a11, X6))) :- p10(f11(f1(X1, X3), a8)).
+p24(f4(a4, X0, f2(X6, a12, _)), f2(f0(a6, a5, a7), f6, f12(a2))).
+p5.
+p10(a5, f8(f12, a3, f13), f4(f12(X4, X4), f2(a6), a2)).
+p28(f12(f0(a12), f3(X0, X0, a9)), a11) :- p8(f12, f11(f13(a10, X6, a8), f7(a0, X4, a12)), f6), p10(f6(f2(X2, X5), f9)).
+p30(f11(f0, a4, f15), f13(f8(X6, a7))).
+p26 :- p26(f7).
+p21(f1(f4, X5, f7(a10, a1)), f5(f7(X2, _))) :- p2(a2, f13).
+p29(a4) :- p3, p25(f3(X4, f12(X6), f11)).
+p18(a1, a14, f3(X4)) :- p1(X4), X7 = f11(f6(a9, a10, X0)).
+p5 :- p29(f2(f6(a5, X1))), p25(a11, f3(a5, f3(a4), X3), f10), p19(a9, f11(f15(a12), f6(a12, a4))).
+p2 :- X6 = f1(f12, f9, f10(a13, X1)), p16(X4, f7).
+p14(f4, f15(f14, f4(a0, X3))) :- p0, X2 = X3, p17(f0(X3, a8, X1), f6(X0, X5), X7).
+p7 :- X7 = f13(f2), p26(f5, f3(a13, f7), f1(f7(X7, X5), f14(a5, _, a14))).
+p25(f10(a15, f13(X3, X5, a13), a3), X4).
+p14(f9(f12, f3(a11, a15, _), f9(X5, X0)), f11(f2(a9, _, X6), f0(_), f1(X6, X5, a7)), f8(f8(X3, X2, X0))) :- p10(a1), p30(f6, f13(f13(a13, a13)), f9(f5(a12, a12), f6(a7), f4(a7, X1, a11))), p21(f5(X4, X3, f11(X1, a3, X3)), a3).
+p21(f3(f1(X4, a10), a15, f11(X5, X2)), f4(f13, f3(X0))).
+p9(a9, a5) :- p29(f1(f5(a4, X3, a10), f11(X0, a8)), a0), p3(f2(_, X4, X5), f6(a5, f4(a9))).
+p6(f15(f5(a14, _), f14), a9, f0(f8, f14, X0)) :- p10(f5(f10(a14), f13(X0, a6), f15(a13, a2, a6)), f5(f3(X6, a0, a5), a14, f9(a15, X2, X4)), a4).
+ :- X3 = f13, p9.
+p25(_).
+p19.
+p22 :- X5 = f15, p14(f9(f14(X2, X6, a7), f0(a13, a2, a3), f4)).
+p18.
+p13.
+p2 :- p30(a5), p20(f12(f0(X3), f12(_)), f13(f8(X3, a4, X2)), f13(f0(a7), f14(X7, a15, X3))).
+p8(X4, a4).
+p3(f2, f10(f6(a0, a5))).
+p8.
+p1(f8(X1, f15, a5), f12(f8(_, a8))) :- _ = X5.
+p0(X6, a3).
+p8(f8(f2(a3, a13, X1)), f3(a11, a8)) :- p31(X5, f10(a1), f8(f15(a7, _, X2), f8(a6, a11, a3), f11(a13))), X5 = f5(a7), p25(a2).
+p8 :- _ = X6.
+p8.
+p28(f1(f0(a4, X4))).
+p12(f14(f9(a5, a3), f14(X0, X6), f10(a15))).
+p20.
+p18(f3) :- p10(a5, a0), p10, p0(f13(f6, X2), a14).
+p15(a6, f10(X4, f6(a11, _), f14(X6, _)), f6(f5, f15(a2, X2))) :- p18(f8(f13(X6, X2, X1)), f3), X2 = f0(X6, a2), p5(f1, f9(a13, f5(a7)), X5).
+p21(f1(f0(a8), f7(X0, a6, a0), f8(a2, a0))).
+p6(f3(f7(a8, a3)), f5(a12, f7(a4, a0, a7))) :- p18, X6 = f15(f15(X7), f5, f8), X4 = a13.
+p5(a1, X0, f11(f0(a2, a0, a7))) :- p20, p9, p15(X3).
+p12(f5(_), f11) :- X7 = f5(f8(X2), a13).
+p14.
+p14(f8(f13, f11(a9, X3), f12(a9, a14, a13))).
+p6(f3(a4, f4(X6)), X3) :- X4 = f15(f10), X0 = f12.
+p1(f12(f13, X3)) :- _ = a8, p15(f4, a3, f13(a10, f13(a2, a5))).
+p10(f12, a1).
+p3(f4(f8(X5, a13, a5), a9), f11(f3(a3, X5, a10), a1, a4)) :- p13(f0, f5(f11)), p19, X0 = f10(f14(a15, X3), f3(a6, a13, X7), f10(a1, a4)).
+p0(f11, f5) :- X3 = X0, X6 = X3, p14(f9(f15(X5))).
+p31(f15, f6(f14(X1), f3(X6))) :- p26(f1(a9, a11), f4(a4, f9(X6, X5, a8))).
+p28(f5, f7(f7(a5, X0))) :- p9(f4).
+p14(f13(f11(a2, X0))) :- p30(f10, f6(f13(a13, a13), f8(X2, a6, a6)), f7(f5(X7))).
+p0.
+p17(f2(a14, f14, X5), f7(a1, f1(X0, X4, a5)), f0(f14, f14(a7, X0, a1), a8)) :- p27(f2(f5, f11(X4))), p2.
+p26(_, f2(f15(X5, a7), f0(X4)), a13).
+p20(f12(f0(X1, X6), f11), f11).
+p13(a1, f6(a11, f5)).
+p20(a5, a13, a12).
+ :- p1(f10(a3), f1), p6(f8(f5(X0)), f8), p15(f2).
+p5(a12, f5, f4(f0, a14)) :- X6 = f8(f4(_, a12), f12), X7 = f1(X0).
+ :- X5 = X5, p19(f4(f11(X6), a3)).
+p26(f3(a9, f1(a2, a4, a4), a12), f3) :- p29(f14(f9(X6), f8(a10, X5))).
+p15(f14(f6), f9(f5, a2, a6), a6) :- p13(f12(X3)), p12.
+p20(a4, a3).
+ :- p19(f2(f8(_), f1, X4), a11, f15(f7(X4, X2))), X2 = X2, p31(f0(f4(a15), f0(a10), f0(a10, X7, a6)), f0, f5(f11(X4), f0(a6), f7(a4, X1, X1))).
+p27(a12, f11(f5, f12(X0)), f1) :- p27, X3 = f1(_, f11, f13), X1 = f1(a9).
+p9 :- _ = f0(X3).
+p0(f3(f3(a4, X6), f7(X1))) :- p4(_, f8(f14, f10, a13)).
+p25(a5, f8(a5, f2(a14)), f12(f9, f5(a3, X1, X5), f4(X5, a3))).
+p15(f12(X6, f4), X2, a0) :- p26(a13, f12), p0(f0, f12(a7, f2(X3)), f1(a9, f8(X4, X7, a3))).
+p22.
+p5(f14(f2, a13), f10) :- p11(f12(f13(a11, X2), X7)), p16(f2), X1 = f14(f7(_, a7), a0, f0(X4)).
+p24(f1(f6(X0), X3)).
+p1(f0(a3, a7, f3(a2, X6)), a15) :- X4 = X4, X4 = a8, p18(f10(a1), a9).
+p6(f0, f2, f4).
+p7(f1).
+p16(f2(a2, f3(X5)), f14(a8)) :- p11(f11(f14), f4(f8(X4, a11), f3), f2(f10(a7, a8, X6))), p1.
+p17.
+p21(f2(a14), f10).
+p5(f12(X5, a6), f3(X1, f4(a6, a5)), f5(f7(X7, a4, X3), f6(a14, X6, a7), f7(a5, a14))).
+p9 :- p23(f5(X3, f6(X4, a7))), p2(f8), p3(f10(f8(_), f3), _, f1).
+p2(f12(f0(a2, a9))) :- p3(a4, f13, f9).
+p7.
+p6(f8) :- X0 = X5.
+p9(a14) :- X5 = a1, X5 = a2, p21.
+p0(f6, f6(f5(X2, a10), f0, X2)).
+p9.
+p17(f9(f13(X4), f2(X2))) :- p27(f0(a11, a2, f13(a1))).
+p24.
+p20(f2).
+p13(f2(X3, X0, f7(a14, X1, a9)), f12(X6, f7(X5, _, X7), f9(X3, a1))).
+p24(f12) :- p18, X4 = a9, p12(f12(f8(a10), f14(a3, X2))).
+p19(f11(f5(a7, a1), f8), f14(X4, f2(_, a5)), f14(X4)).
+p5(f1(f3, a1), _, X5).
+p12(f3).
+p5(a5, f13(X5, f9(X7, X1)), _).
+p27 :- X6 = a0, p28.
+p20(f0(X5, f0, a14), f3(a13)).
+p22.
+p12.
+p15(f0, a2, f7(f15, f4(X2, X3, X4), f11(a5, a11, X5))) :- X1 = f3(f2(a5, a14, a6)), X2 = f12.
+p14(f2(f7), a12) :- p6(f7(f4), f15), p18, p1(f0(a10), f6(X7, f5, X1), f3(a10, f0(a13, X3), f8(X0, a3))).
+p28(f10(X6, f10(a0))).
+p0(f14(a8)).
+p8(f5(_), X5) :- X1 = f1(a8).
+p14(f2, f6(X4, _, X1), a1).
+p6(f7(f10, f9, f15(a6, a0)), a2, f15).
+p9(a9, f4(X7, f4(X0, X0, X2))) :- X6 = f6.
+ :- p15(a15).
+p22(X7, a12, X6).
+p19(a3).
+p17(f14, f4, f11).
+p5 :- p2(X5, f5(a10, f7(X1), a1)).
+p21(f4(a15, f10(X6), f4(a6, X0)), a13) :- p16(f11(X5, f7(a10, X4), f15(a12))).
+p28(f3, f6(a15, f1), f10(f10(X2, X0), f9(X4, a9, X4))) :- p10(f5).
+p18 :- p0.
+p31(f9(f1(a12), f13, a6), f4(X1, f10(X3, a2), f9(X3))) :- p3(f1(a14), f3(f7)).
+p9(a4, f10(X7, a1)) :- p5, p12(f3(a1, f13(X2, X3)), f11(a5), f5).
+ :- p18(f10, f10, a3), p1(f12(f9(a6, X4, X2), f8(X0, a7, X1)), X0, f5(X7)).
+p28(a1, f8(f11(a10, a7), f13(a11))).
+p4(X0, f11, f1(_, f2(a6, X6, _), f15(a4, a7))).
+p2 :- p20.
+p6(X2, f2(f15(X2), f7(a4, a4), f3)).
+p29(f7(X6, f15(a13)), a9, X5) :- p19(f14, f11, f12(f11(X7, X0))), p7(f14).
+p12(f6).
+p19.
+p12(a5, X3).
+p16 :- X6 = f13(f1(X1), X5, a11).
+p5 :- p23(a9, f13(a1, f14(X5))), p9.
+p12(f8, f4) :- X1 = a11, X0 = a15, p5(f5, f5(f13(X6, a11), f13(X1, _), X0)).
+p16(f12(a9, f6(X4), a14), X3, f3(X0, f4(X0))) :- p7(f0(f1(a8, a0, X7)), a6), p25.
+ :- p8, p18, p22(f11(f9, a2, f12(X6)), f6(f13(a13, X7), f9, X0), a9).
+p22(f10(f0(a9), f14(X1, a10, X4), f0(a1, X4, X3)), f9(f10(X7, X7))) :- p7, p2(X3, f8(f14(X5), a5, a9)).
+p7(f13(f12(a15, X4), f1)).
+p6(a9, f13(f0(X7)), f8(f2)) :- p12(f15(X1), f6, a11), p20(f12, f8, X1), p12(f3(f7(a3, X0, a14), f6(X0, a13), a12), f4(f7, f7)).
+p3(f10(_), f1(f10(a8, a9), f9(a4, X7, _))) :- X3 = _.
+ :- X1 = f7, X6 = a14, X7 = X7.
+p25(f1, f7).
+p6.
+p17(f15(f13(a2, X6)), a15, f6).
+p0(f0, f10(f15(X3, a6, a8)), f11(f14)).
+p29 :- _ = f6(f15(a5), X5, X3).
+p8(X0, a6, a6).
+ :- p6, p13.
+p26(f13, f12, f8).
+p19(f10(f5(a10)), f2(X4, f10(X0, a12, a11), a3), f5(f13(X2), f14(a9, X2, X2))) :- p19(f13, f3(f12(a0, _), f15(_), a13), f7(f1(X3, _), f1)), p27(f14(a13, f4(a2, X3), f8(X7, a4, a13)), X6).
+p7(f10, X0, X0) :- p5(f8(f7(_), f5(a14, a10), f9(X5)), f4(f13(X5, X5), X7)), p16(f0(a4, f5(a5), X3)).
+p22 :- p28, p22(f9, f6(f13(a10, a11, X1), f12(a1, X0), f10(X6, X7)), f6).
+p24(f6, f6(X5, f6(X7), f11(a6)), a14) :- _ = a11.
+p8(f13(f4(X3, a4, X1)), X5).
+p3.
+p23(f14(f5, X5, f14(X2, X6, X7)), X2) :- p7, p31(f3(f14, f8(X3, _, a14), f14), a15), p4(f7(a3, a8, f7), X6).
+p26(a9) :- p31(f12(f2, f11(X5, a15))).
+p7(f0, _, f6(f1(a1, X1))) :- p6(f9(a4), _, f1(a6, X6, a6)), p6, X4 = X3.
+p1(f5, f3(f4(a5, a6, _), f12(X2, _, X2), f7(X5, a0, a2)), X5).
+p20(f3(X2, f10(a11, X2), f6), X7) :- p17, p12, p12(f2(X2, X0, a2), f4(f15(a10, a5, a5), a8)).
+ :- p10(X7, f1(f10), X4), p7(f11(f14(a6))).
+p4(f6(a6, a2, f0(X1, _)), a2, f3(f14, a14)) :- p5(f0(f5, f9(X1, X6, a2))), p4(f2(a7, a1), f13(X1, f5(a10, _, X2), f6(X6, X5))), _ = a4.
+p4 :- p3(a3), p4(f6(X3, f7(a14, X0)), f9(f9(X1), f5(X0, a8))).
+p30(X1, f10(f9, f12(a14, a14, a1), f10(a6, a0, X2))) :- X1 = f10(a10, f7(a1, X5)), p6(f11, f12, a7), p20(f8(_, f7(_, _))).
+p0(f11(X7, X2, f8(a14, a9)), X0) :- p28.
+p4(X3, f3(f7, f7(a3, X1)), f0) :- p16.
+p27(f15(f7(a7, a11, X3), a15, f6(X7)), f12, f7(f6(a1, X5))) :- p5(f1(a14, f7(X4)), f14(f9, f1(X1, a6), X0), X6), p31(f6).
+p10(f1(f10(X5, X0, a3), X0), _, f2(f14(a11), f15(_, a13, a1))).
+p23.
+p11(f2, f2(f12(a10))).
+p12 :- p7(f9(f6, f10(_, a10, X4), f2), f5(f13, a6)), X0 = f11, p16(f5(a4), X6).
+p26(f13(X6, a10, f14(a3)), a15, a6) :- p30(f6(a15, f10(X1, X2, X7), a8)).
+p21(a15, X6, X2) :- p23(X3, f15(f13(a13, a1), f1(X1))), p11(f8(f15(_, a14, a13))), p11(f2(X7), X7).
+p29(_).
+p8.
+p15(f15(f13(a14, X5), f10(a6))) :- p11(f10(f2(a11)), f4), p20(X2, f14(f2(a6), f7)).
+p4(f4) :- p26(f7(f7, f7(X7, X4, X4)), _, a11), p2(a10).
+p4(f5(a12, f15(a15, X1)), f5(a0, f15(X7, a2), a12)).
+p28(f8(f0, f10(X3, a10), f14(X1))).
+p4(f8(X7), f13(X1)).
+p21(a2, a11, _) :- p18(a2, f1(f7(X1), a11)), _ = X5.
+p4(a1).
+p19(f4(f5(X7), X4, X5), f5(X4, f2(X0, a10))).
+p31(f0, f11(f1(a11))).
+p5.
+p29 :- _ = f13(f3(X6, X1), f6(X7)), _ = f10(f12, f12(X2, X1), f3(a4, X5, a9)), _ = f10(a14).
+p21(f1, X3).
+p25(f14(f5(a12), f1(X1)), X3) :- p3(X5).
+p12.
+p2(f15(X4, f8(a1))) :- p28(f14(f1(a12, a9))).
+p18.
+p10(_) :- p18, p17(f11(f7)).
+p4(a7, f10(f10, f11(X4), f3(a9))) :- X2 = f10(f3, f14(a2, X3)), X2 = a14.
+p24(a11) :- p1(X2, _, a1), p0(X0).
+p8 :- p15(f7(X5, f1, f2), f7(f8, f9(a14, a8, X0), f15(_))), p23(X0).
+p22(a9) :- p17, p30(f10(f0(a6, X1), f11(a1, a7, X6), a9), f12(X4), f14(f8(a3, a5), f3(X5, X6, X5))), p9(a6, f11(a14, f15(a15, a4))).
+p28.
+p17.
+p1.
+p1(f9(f3(X5), f11(a7)), X6, a1) :- p28(f9(f1(a3), f5(_, a2), a12)).
+p18(a15, a9).
+ :- p5(f1), p4(f14(f5(a12, a11, X0), f13), f12(f1(a15)), f5(f7)).
+p30(f15(f15(a6, a3, a14), f7(a2)), f10(X2, f0(X2, a5, X5))).
+p24(f8(f13(X3, a1, X7), a7), f13, f15).
+p27(X2, f8(f9(X2, X2), _)).
+p13(X1, X7, f12(f10(a8))) :- X2 = X6, X1 = X1, p4(f12(f5, X1, f12), X2, a7).
+p21 :- p29(f7(f10(a15, X4)), X3, f5(f3(X4), f8(a6, a5, a5))), p16(a3), p10.
+p7(f14, a5, f13(f7, f5(X0))) :- p4(f15(X6)).
+p25(f12(f7), f13(f9(X4), f12(a12), f15(a1))) :- p22(f15(a13), f3(a14)), p23.
+p5(X5) :- X7 = f1.
+p23(f0(a13, a7, f5(a12)), f7, a15) :- p7(a7, f15, f7(f2, a13, f9(a5, X7, X6))), X3 = f15.
+p12(f10, f11(f2(X5), a15, f14(a0, a15, a10))) :- p27, p15(a14, X6, _), p14(f5, f7, f11(X4, a4, f3(X0, _))).
+p29(a12, f12(f4(a14, a14), a0), f0(f7(X3), X5)) :- p7(f1(a6, a6, X3)).
+p18(f0(a10, a3)) :- X4 = f11(a7), p5(a14, a8), X7 = X6.
+p19(X6, f1(X3)).
+p5(_).
+p14(f14(X0, f10(a1, X1, X6)), a5) :- p26(f2(X0, a1), X4), p17(X4, f9(f9(a6))).
+p3 :- p14(a3, a14, f11(f6(a7, a5, a15), f2(a4, X3))).
+p23(f4(f10(X3))) :- X7 = a15.
+p31.
+p31 :- p17(f1(X1, f9(a5, a11, a10), a1), f3, f12(f1(X1, X4))), p27(a14), p30(a3, f11(a4, f15(a1, X0, a4), a4), X5).
+p22.
+p3 :- p19(f7), p24(f3(f5(a12), a12), a4), p21.
+p0(f5(X3, f1(a7, a14, X4), a7), f13(f1(a10, _, a13))) :- p22(f5), p26, X5 = a7.
+p4.
+p6(f4) :- p6(a10), X7 = a8.
+p6 :- p1(f0(f8(X7, a15, a1), a5, a3), X3, a9), p7(f15, f1(f10(X1, X5)), f15(X5, f6)).
+p9(f1(f1(a9, X4, a10), f5(X1, X7, a2))) :- X1 = f10(f3(_)).
+p0(X6, X0) :- p12, p0(f0(f3(X4), f1)), p13.
+p24 :- p12(a0, a5, a4), p12(X0), p21(a14, f1(X2, f6(X7, a6, a1))).
+p24(f13) :- p11(a13), p10, X4 = f3(f11).
+p26(f2(f0(X0), f6)) :- p21(f9(f7(a7, a10))).
+p18(f14(a11, X6, f4(a14, a6, X2)), _) :- p15(f3), p26, p10(f6(a14, f3(a1, a12), f9(X6)), f11(f10(_, a5, a14))).
+p2(f3(f14)) :- _ = _.
+p21(f1(f0, a11), a0) :- p6(a0).
+p11(X1, f11(f4(X7, X3), X5, a0)) :- p3, p2.
+p15(X0, f5(X4, a6), f14).
+p3(f1, a14) :- p29(f6(f9(X6), f4, f8(X0, a15, a12))).
+p8(f7, f2, f2(a15, X5)).
+p14(f12(a3, X6, f1(_))) :- p22.
+p29(a4, f9(f5(X0), a0, f15), f4).
+p30.
+p3(_) :- p12(f10(a8, f2(_)), X1), p24.
+p0(f8(f2(a15), a3, a7), f14).
+p26(f6, f12(f2)) :- p25(f1, X2, a11), p9, X5 = f9(f15(X2, a9, X3)).
+p1(f11(X0), a10, a8) :- p28.
+p14.
+p28.
+p17(X5, f3(f12(a15, a5), X5, X3), f6(f14(a8), f14(X2, a8))) :- X5 = f14, X4 = f12(f1(a15, a3), f12(a8, a9, X1), f12).
+p17(f9(f7(X1, X6, a8), f1(a3, a7), a5), f0(f14(a14), a8), f4(f1(X3), f4(X2), f12(X5))).
+p24 :- p3, p19.
+p30 :- X4 = f11(f12(a4, X4), X0, a14), p15(f5(f15(_, a10, X6), X6, f14), a14).
+p23(f7(f6(X6), f14(X5, a9), f10(a3, X4, X2)), f13(a7, a14, f0(_))) :- p8(f15, f2(X7), f14(f0(a3, X1), f3(a2, a12), f1(a8, X2))), p17(X7, f11(f0), X2).
+p11(f9(f4(_), a10, _), f2(f3(a3), f0(a15), X2), a13) :- p4(f12(a4), f0, X3), p1(f14, f3(f1, f10(X6, a13, X7), f4(a4))), X2 = f1(X6).
+p21(f6(f10(a7, X1, a10)), f7, f5) :- p23, p9(f6(f9(X5, a2), f2, f14), a5).
+p11(X0, a9).
+p4(f10(f10(X5, X3, X6), f0(a1, a0, a7), X5), f14(f7(_), X4)).
+p7(f15(a0, f11, f8)).
+p17(f9(f2(X2)), f5(X4), f1(f5)) :- X7 = f12.
+p25(X3, f15(f11(a10))) :- X0 = a15, p17(f11(f9(X1))).
+p19(f13, X2) :- p9(f0(a11)).
+p18(f14(a13, f2(a5), f12(a6, X1)), f15(f13), f8) :- p31(a10).
+p9(a13) :- p7(X4).
+p22(f15(f12(X6, X1), f12(a0, X4, a9)), f10(X3), f14(f6(a8, X6), f0(a9, X6), X6)) :- p21(f4(f15(a8, X2, X5)), f0(a5, X5, f6)), X3 = X7.
+p21.
+p30(f4(f1(a1), a3)) :- p6(f9(a11, f9, X1)), p20(f8(f14)), p9(f8(a10), a11, X5).
+p21(f3(X0), a12) :- X2 = X7.
+p29(a8, f8, X6).
+p3(f4(f7(a0)), f8(a2, f10(X1, a10))).
+p4(f5(f4(_), f6), X7).
+p26(f10(f15(a11, X0), X1), f9, f13(f4(a13, X6, X5), f14(X5, X1))).
+p23(X0, X1).
+p14.
+p25(f13) :- X7 = f12(a6, X6, f8(X1, a7)), X2 = f15(X1, f6(X1, X2, X7), f6(a1)).
+p24(f1, f3(f15(a12, X0), f3(a10, X0, a8))).
+p9(f10(f5(X4, X0), X1, f7(X1, X0)), a4) :- p0, X1 = f5(f2(X6)).
+p1(a6, f10(X0), f0(f15(X3, X4, a0), X7)).
+p10.
+ :- p25(f2(X7, X5), _, f3(f2)).
+p1(f5(f3, X2, X3), f14(f9, f13(a5, a8)), f6(a15)).
+ :- X4 = f1(f0(a5), f2(X2, a3)), p22(X0), p28.
+p18.
+p21 :- p1(f1(f8(a2, X7), f0(a1))).
+p10(f13(f4(a14)), X1, f5(X3, f0(a3, a1, X2))).
+p20.
+p10(f13(f8(a5, X1, a13))) :- X4 = f1(f14, a15), p0(f3(X7), a5, f8(f3, f11)).
+p7(f2(f14(X6, X3), a6, f11(a9, a6))) :- p0(f3(a4, f13(X4, X1, a8), f9(a7, X1))), X0 = X0, p25(a15, f14(f12, f11(a5, a2))).
+p30 :- p26(f9(f2, X1)), p29(f1(f13)).
+p14(a2, f14(f5(a11, a3, a1)), _) :- p21(a14), X4 = f9(X6), p20(a6, f7, f15(a11, f13(a1), f8)).
+p3(f7(X0, f9(a11)), f10(a5, f2), X3) :- p25(f6(f6(X1))), p4(f5(X3)), p29(f2(f2(a11)), X6).
+p10(f0(a12, f11(X5), f5(X3, a2)), f14, f3).
+ :- X3 = f11(f10(a3, a5, X5), f14(_, X3, a5)).
+p7(f4(f11(X1), X6, X1), f4(f15(X5, _), a8), f9(a7, f2(a2, a3, a2), a8)) :- p11(a3, f4(a7)).
+p16(f0(a3, f10(X7), f11), f14).
+p20(f14) :- p25(f15(X2)), p26, p29(X3, f4(X1)).
+p25(f7(f13(X4, X6, X3), f3(X0, a6), f7), a12, X0) :- X5 = f7(a7, a13), p29(f15(f7(a6, a11, X6)), f3(f10, f6(X7, X2), a14), f7(a7)), X4 = X5.
+p22(f11(a8, f4, f11(X4, X1)), a11, a3) :- p16.
+p10(f10(a12, f13(a6, _, X5), f10(a3, a2))).
+p27(a1).
+p14(X4).
+p31(f11, f7(f0(_, X1, X3)), f7) :- p26.
+p25(a8, f6(f3(X1, X4, X6), f1, a9), f14(f11(X6), f2(X6, X7, X1))) :- p23(f7), X5 = f11, p26.
+p18 :- X2 = f4(f9, f8(X7), f12(a1)).
+p25(f3(f1(a15, a15), a11), f1(f0(X4, a11))).
+p31(f10(f15, X3, _), f10(f15(a7, a7, X7)), f7) :- p2(X7, f6(f5(X5, X1, a5), X1, f11(a5, X2, a1))).
+p20(X4) :- p5(f5(f11(X1))), p23(f10(f11(a6, a13, a8), f12(a3, a8))), X6 = f15.
+p20 :- p18(f7).
+p28(f6(f0(a8), X6, X5), X2, _).
+p8(X0) :- p13(_).
+p4(f11(_, X0, a7), f7(f9(X1, a13, X4), a12, X0)) :- X3 = f5(f3(X1), f4(X1, X6)), p0(X4, f4(f7(X5, X4, a1))).
+p14(a7, f9(f1(X1, X2, a4))) :- p1(f11(a4, X5, f8(a3, a14, a7)), a1), p1, X3 = f4(X3, f3(a2, X2), f9(X3, X1, _)).
+p11(f5(f0(a4, a14, X4)), f4(X1), f0(f7, f8)) :- p9(f3(f13(a9))), p22, X0 = f9(f9(X7), X0).
+p5(f1, _).
+p14(f5(f9, f5(X3, a1, a2), f0), f14(a15, f4, f4(a11, X0)), f8(f3(a10, _))) :- p23.
+p21(f14(f13(X6, X7), X1, f1(a5)), f1(X4, X1), f2(f15(X4, a2, a2), a2)) :- p24(f0(f12(a12, X0)), f14(f7(a10, a7, X5), f9(X1, a11, X6), f13(X7, _, X2)), a11), p27(f4).
+p22.
+p0.
+p9 :- p7, p4.
+p8(X4, f9(X2, a1, a4)) :- p5(f14(f6(X0), f3)), p9(X2, f1(f8)).
+p7(X1) :- p4(f4(f2(a12)), a2, a12), p13(f0(f15(a0), f1(a4, a0), f1(X4, a0, a11)), X6), p7(f13(a8), a10).
+p12.
+p11(f4(a0, X0), a7, f1(a7)) :- p27(f0(a0, a7, f0(a12, a12, a4)), f9(f12(a13), f9(X2), f0(a2)), f2).
+p11 :- p12(f13(f0(X1, X5, X7), f13(a8, X6, X5)), a10, f10(f7(a12, a0, _))), X1 = a10, p27.
+p21.
+p10(f5(f11(a14, a7), a14, a5)) :- p26(f0(f15, a13)), p18(f6(f6(a10, X3))).
+p10(a0, f6(f5(a12, X5), a9, f10(a2, a2, a6)), X1).
+p26(f4).
+p9(a4, f2(f9(_, X2, X7), f4(a0, X4)), a15).
+p2(a12, f0(f4(a12), a15)).
+ :- p21(f15(X5)).
+p23(X0).
+p20(f9(f8(X5)), X3).
+p28(a6, f6, X0).
+p4(f9(f2(_, a12), f7(a9, a7, X3))) :- p12(f7(X4, a4, f2(X5, a7, X0))), X7 = f6.
+p8(X1, f10(f10, f14(X2, X4, X1))) :- p4(a2), p6(a4), p28.
+p1.
+p26(f1(f4, X1)).
+p7(f4, f4, X7).
+p21(f14) :- _ = a4.
+p11(a14).
+p4 :- p11.
+p6(f11(f14), f5(X7, f8(X0, _, X3)), f13) :- X3 = X5, p5(X1, f6), p15(a14, a0, f10).
+p12(f3(f9(a1)), a4) :- p19(f10), X0 = f10(X3, f11(a3, X4), f4(X1, _, X1)), X7 = f8(f4(a11, _, X7), f4(_, a9), _).
+p10(f4).
+p17 :- p26(f6(f12), a11), p10(f11(f0(a11, X3), X6, f8), f2(a14, f0)), p6(f6(f0, f7(X0, _), f5(a4, _, X6))).
+p7(f4, a4).
+p11(f11(a7, f4(X4, a7, X4)), f14) :- p17.
+p3(X1, a14, f1(f7(X0, a4), f11(a12))) :- p13, X4 = f7.
+p18(f8(f4(a15)), f15) :- p7, p25(a1, f15(a5)), p25(f8(X1, f11(X5, a3))).
+p3(f4(X7), a0, X7).
+p3(f0(X1, X3), f7(f4(a11, X4), f8)).
+p20(X3) :- p1(f5, f8(X6, f7(a9, a11), X7)).
+p18(f2(f10), X2, f10(_)) :- p1(f10, X3), p30, p11.
+ :- p13(f3, a12).
+p25(f7(f5(a0, a8), f1(a11, X1), a4), X5, f6(f8(a14))).
+p30 :- X0 = f5(f1(X3, a14, a5), f14(X7, X5)), X3 = f5(f0(X6, X6), f0(X7, _), a1), p2.
+p0 :- X6 = f15(f9(X2), a6, _).
+p7.
+p22.
+p20(f14(f13(a3), f0(X4, X7)), f3(f1(X6, X3))) :- p25(f4, f0(X3), f15(f12(X3), f2(X6, a4))), X3 = f8(_, a15).
+p2 :- p16(X6, X7, a3), X4 = f15(f0(a1, a3), a7).
+p13 :- X3 = f13(f13, a1, a13), X4 = a14.
+p21.
+p20(f3(f11, f1(X1, a12, X5)), f6) :- p31(f15(a15, f9(a6, X1, a6)), f7(a15, f1(_), a8), f0(f4(_, X2))), p18(a5, X0), p24(f3(f14(a6, X0, X4)), a5, f3(f13(_, X2))).
+p31.
+p7(f1(a0, f5, f11(X3)), f14, X2) :- p17, p26(f13(f15), f15(X0, f9(X1, a1, X4), f1(X5, X1)), f14(f1(a0, a15, X0), f11(a1, X6))), p11(f9).
+p26(X6, X2) :- p6(f1(f14), a12, f9(f6(X7, X0, X1))).
+p0(f5(f5(X2), f10(X6)), f11(f5)) :- X4 = f13, p4(f10, a3).
+p6(_, _).
+p17(f2, f14(f9, f8(X3, a10), f7(a6, a11))).
+p28(X3, f10(f7(a15))).
+p10.
+p24(X0, f2).
+p15(f2, f12(f12), X7) :- p2(a2, f10(f4(a3, a4, _), f11(X2), f13)), X3 = f11.
+p9(f7, f8(a14, a12, f10)).
+p25 :- p2, X3 = f3, p14(f0(f8(a1, a5), f2(a10, X6))).
+p16(f10(f15(a14), f4(X1, X3)), f9(f1(X1), a5), a6) :- p8, p0(X2, f12(f3(a1, a0, _)), X2), p8(f4).
+p25.
+p9(f1) :- p23(f15(f5(X3, a5)), f13(f12(a1, a14, X2), X4, f6(X2, X7))), X4 = f9(f11(X3, a14, _)).
+p15(f7(a15, X6), f13(f1, f0(a3, X1, X3), f8(a13)), f0(f10, f9, f4(X7, X3))) :- p7.
+p6(X3) :- p21(a7, f6(f2, f6(a0, X4, a13), X7)), p12(f13(f13(a6, a4, X2), f13), f8, X4), p8(a8, _, f15(f12)).
+p29(X6).
+p12(f9(f7(_, X6, a13))).
+p5(f1(f12(a2, a7, X2), f12(a12, X3), a3), f14(a12), a15) :- p24(f5, X1), p28(f8(X7, a6, X7)), p15.
+p2(f12(f0(X0, X7, a12), f13(_), f11), f3(f12(a3, a11), f11(X0, a4, a3), a6), f0(a9)).
+p3(a5).
+ :- X0 = f15(f11(a9)).
+ :- p5(a6).
+p25(f7(f1(X5, a1, X4), a5), f10) :- p23, p7(f11(f9(a14, X4, a1)), f10, f3(f15(X3), f0(X7, a13))), p16.
+p20(f6, a11, f12) :- p5(a11, _, f5(f0(a2, X5), f0(a11, X5, a15), f11(X6, _))).
+p24.
+p9.
+p30 :- p5(a0, X0), p18(a13, f3(f3, _), f2(f2, a5)), p3(a12).
+p14(f10, X5, f3) :- p2.
+p21 :- X2 = a5, p25(f15(a6, a9, a3), f3, a10), X2 = a4.
+p12(a1, a4).
+ :- p2(f11(f11(X7, X4)), X3), X4 = f12(f2, a14), p31(f1(a14, f6(a10), a7)).
+p4(X2, a4).
+p14.
+p8(f3(f9(X5), f12, f3(X2, X0, X0)), X2) :- p20.
+p18(a1, f13(X6, a12, X2)) :- X0 = f13(X3, f3, f9(a6)).
+ :- p8, p11(f4(f4, f2(X4, X3)), f1(a6), f10), X4 = f5(f8, f12(X2, a11)).
+p22.
+p2(a4, f9(f2(X2, a14, X3), f13, f11), f5(f0(X3, _, X5), f13(X6))).
+p12.
+p1(X3, f9, f1(a5, f7, f13(a15))) :- X7 = a10, p29.
+p26(f12(a5, f5(X3, a0))) :- X2 = X6.
+p26.
+p15(a4) :- p18, p31, X5 = _.
+p0 :- p27(X4), X4 = a4.
+p23(f10(f12), f5(X2, f4, a13)) :- p26.
+p21.
+p12(f3(f2, a4), a9, a4) :- X4 = f7(a14), p4(a8, f5), p25(f14(X6)).
+p0 :- X7 = X5, p25.
+p21(f1(f14(a3, _, X1), a5, f1(X4, a5))) :- p24(a13).
+p13(_, f11(f2), f14(f15(a14, a10), f1(X1, X7, a8), f3)).
+p26(f6(X4, f0, a11), X5, f15).
+p4(f10(f2(X2), f11(a2, a13))) :- p26(f3(X4)).
+p14.
+p15(f6(f11(a13, a3, a3), f7(X2), f15), X3, X4) :- X5 = X6, X4 = f9(a13, f4(a14, _, X1)), p25.
+p5.
+p26(f13).
+ :- p16, X6 = f0.
+ :- X2 = f9(f4, f6(a2, a4, X5), f10), X7 = f0.
+p18 :- p3(f5, X0).
+p24(f15(_, a8, f8(a5)), f7(f0(a5), f5)).
+p17(f5, f10(a8, a14, f0)).
+p19(f4(f7(a5, X1), f2, a4), f1, f2).
+p8(f5(f11(a0, a1, X2)), f0) :- p2, p30, p27(f6, f3(f15, X5, f9(_)), f6(X1, a12, X4)).
+p27(a2, f3(f3), f5) :- p21(_, a11, f15(f3(X7, a4), f6(a1, X7, X1), f3)), p17(f8(X5, f4(a0, X3, X2)), a8).
+p0.
+ :- p12(f4(_)), p17(X3, X2), p10(f14(X0, f11(a6, X5)), a3).
+p29(f11(X0), f3).
+p21(f11(f15(X7, X6), a5), f6(f2(X5, a11), f1(_, X4), f6)).
+p28.
+p17 :- p3(a2, f0(a15, X0, a3), X3).
+p1(f13, f3(f1(a1, a1))) :- _ = f13(X0, f11(a15, a14), f13).
+p12(f2(f9(a9, X5)), X3, X1).
+p15(f13(f1(a1, a11, X7), f3(a9, X5, a7), f6(a7, X0, a12))) :- p4, p10(a5, f7, X3).
+p1(X3).
+p9.
+p8 :- p7, p7(f12(f15(a6), f1(a15, a11)), a15).
+p29(f3(X5, f11(a2, X6), f9(X1, X4)), f11(f9(X1, X7, X5), f8(X4), f2), a7) :- p19(f6(X5, f15(a15, X0, a4)), f7(f3, f6(X3, X4), f11)), p23(f7(a11, f15(a14)), f14(_, f8(a7, a15, _)), a10).
+p13(f1(X3), f0(a5, a12)) :- p12, p30(f14(X1), f10(X3, f1(X0), f12(a10))).
+p7(f3(a2, X1, f1), a11, a9) :- p1(f13(f6(X2), f3(a12), f2(X7)), f9(f15)), p25(a9), _ = f14(a11, a8, f6).
+p20(f12(f0(X0, a8, a10), f13(X5, a0)), f11(f7(X6, a12), f15(a2)), f5(f10(a13), f8(X5, X5), f13(X5, a5))) :- p16(f7(f1(a9, X3, X3)), a12), p8.
+p18(f3, f14(f8)) :- p13(f1(f2(X5, a15))), p20(f7(f1(X4)), f13(f14(a8), f4(a12, a12), f7(X2, X6)), f9(f7(X7), f3, f0)).
+p29(f7(f10(X2)), f9(f2, f13(a15, a4), f13), f1) :- p19, p16(a1).
+p25 :- p31(a13, f3(f9(X0, a1)), a9), p1(f2(f10(a11, X4), f7, X1), f12(f1(_), X0, f9), f1).
+p21(f13) :- X1 = X3, X4 = a1, p16.
+p4(f5(f6(a6, X6)), X3, X1).
+p12.
+p1 :- p11.
+p27(f7(f11(a3, a1), f4(a2, a4), a12)) :- p5(X7, f10(_, f8(X1))).
+p27 :- p18(f8, a11, f9(f15(a3, X5, X3), a4, X3)).
+p22(f3(f8(a1, _, X6), f15), f2(X7), f14(f8)) :- p26, p31.
+p3(f11(f15, a9, f11(X1, a9, X5))).
@@ -2,11 +2,18 @@
 #include <iostream>
 #include <vector>
 #include <sstream>
+#include <random>
 
 #include "templateio.hpp"
 #include "parser_combinators.hpp"
 #include "profile.hpp"
 #include "stream_iterator.hpp"
+#include "memory_range.hpp"
+#include "arena.hpp"
+#include "parallel.hpp"
+#if !defined(USE_MMAP) && !defined(USE_MEMORY)
+#include "push_parser.hpp"
+#endif
 
 using namespace std;
 
@@ -15,8 +22,8 @@ using namespace std;
 
 struct parse_int {
     parse_int() {}
-    void operator() (vector<int> *ts, string const& num) const {
-        ts->push_back(stoi(num));
+    void operator() (vector<int> *ts, int num) const {
+        ts->push_back(num);
     }
 } const parse_int;
 
@@ -27,7 +34,7 @@ struct parse_line {
     }
 } const parse_line;
 
-auto const number_tok = tokenise(some(accept(is_digit)));
+auto const number_tok = tokenise(accept_int<int>());
 auto const separator_tok = tokenise(accept(is_char(',')));
 
 auto const parse_csv = strict("error parsing csv",
@@ -49,8 +56,8 @@ int parse(Range const &r) {
     }
 
     int sum = 0;
-    for (int i = 0; i < a.size(); ++i) {
-        for (int j = 0; j < a[i].size(); j++) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (size_t j = 0; j < a[i].size(); j++) {
            sum += a[i][j];
         }
     }
@@ -60,19 +67,686 @@ int parse(Range const &r) {
     return i - r.first;
 }
 
+//----------------------------------------------------------------------------
+// Regression tests, run when no input files are given.
+
+int failures = 0;
+
+void check(bool const ok, string const& what) {
+    if (!ok) {
+        cerr << "FAIL: " << what << "\n";
+        ++failures;
+    }
+}
+
+// The error message for 'r', or an empty string if it parses.
+template <typename Parser, typename Range>
+string parse_message(Parser const& p, Range const& r) {
+    typename Range::iterator i = r.first;
+    typename Parser::result_type a;
+    try {
+        p(i, r, &a);
+    } catch (parse_error const& e) {
+        return e.what();
+    }
+    return "";
+}
+
+void test_stream_range() {
+#if !defined(USE_MMAP) && !defined(USE_MEMORY)
+    // An error at the end of a line longer than the stream buffer: the echo
+    // re-reads the discarded start of the line, relative to where the stream
+    // was when the range was opened.
+    string line = "0";
+    for (int i = 1; line.size() < 400000; ++i) {
+        line += "," + to_string(i);
+    }
+    string const text = "1,2\n" + line + ",x\n";
+    string const skipped = "skipped header\n";
+
+    istringstream in(skipped + text);
+    string header;
+    getline(in, header);
+    stream_range const s(in);
+    string const from_stream = parse_message(parse_csv, s);
+
+    memory_range const m(text);
+    string const from_memory = parse_message(parse_csv, m);
+
+    check(!from_memory.empty(), "csv error is reported");
+    check(from_stream == from_memory, "stream echo of discarded input matches memory");
+#endif
+}
+
+// The span 'p' matches at the start of 'r', or "FAIL".
+template <typename Parser, typename Range>
+string span_of(Parser const& p, Range const& r) {
+    typename Range::iterator i = r.first;
+    char_span a;
+    return span(p)(i, r, &a) ? a.str() : "FAIL";
+}
+
+// A span is the input matched, over contiguous and buffered input alike.
+void test_span() {
+    string const text = "12, 34";
+    auto const digits = some(accept(is_digit));
+    auto const digits_sep = digits && discard(accept(is_char(',')));
+    memory_range const m(text);
+    check(span_of(digits, m) == "12", "span over memory");
+    check(span_of(digits_sep, m) == "12,", "span over memory includes discarded input");
+    check(span_of(number_tok, m) == "12", "span over memory of an int");
+#if !defined(USE_MMAP) && !defined(USE_MEMORY)
+    istringstream in1(text), in2(text), in3(text);
+    stream_range const s1(in1), s2(in2), s3(in3);
+    check(span_of(digits, s1) == "12", "span over a stream");
+    check(span_of(digits_sep, s2) == "12,", "span over a stream includes discarded input");
+    check(span_of(number_tok, s3) == "12", "span over a stream of an int");
+#endif
+
+    char_span a;
+    {
+        char_span const owner(string("abc"));
+        a = owner;
+    }
+    check(a == "abc", "copied span owns its symbols");
+    char_span const empty_owner(string(""));
+    char_span const b(empty_owner);
+    check(b.empty() && b.data() != empty_owner.data(), "copied empty span owns its storage");
+    char_span& c = a;
+    a = move(c);
+    check(a == "abc", "span survives self move");
+    char_span const d(move(a));
+    check(d == "abc" && a.empty(), "moved span takes the symbols");
+}
+
+// The excluded string is compared with the parser's result, so a token's
+// trailing space does not matter.
+void test_except() {
+    auto const word = tokenise(some(accept(is_alpha))) - "x";
+    string const x = "x y";
+    string const xy = "xy z";
+    memory_range const mx(x);
+    memory_range const mxy(xy);
+    string a;
+    memory_range::iterator i = mx.first;
+    check(!word(i, mx, &a), "except rejects the excluded token");
+    i = mxy.first;
+    check(word(i, mxy, &a) && a == "xy", "except accepts other tokens");
+}
+
+// How 'p' parses the start of 'text': "value/length" on success, "fail" if
+// it fails where it started, "consumed" if it fails after consuming input,
+// and "error" if it throws. Without 'keep' no result is asked for.
+template <typename Parser>
+string outcome(Parser const& p, string const& text, bool const keep = true) {
+    memory_range const r(text);
+    memory_range::iterator i = r.first;
+    typename Parser::result_type v = 0;
+    try {
+        if (!p(i, r, keep ? &v : nullptr)) {
+            return (i == r.first) ? "fail" : "consumed";
+        }
+    } catch (parse_error const&) {
+        return "error";
+    }
+    stringstream out;
+    out << v << "/" << (i - r.first);
+    return out.str();
+}
+
+void test_numbers() {
+    auto const ints = accept_int<int>();
+    check(outcome(ints, "2147483647") == "2147483647/10", "int max");
+    check(outcome(ints, "-2147483648") == "-2147483648/11", "int min");
+    check(outcome(ints, "2147483648") == "error", "int overflow");
+    check(outcome(ints, "-2147483649") == "error", "int underflow");
+    check(outcome(ints, "2147483648", false) == "error", "int overflow without a result");
+    check(outcome(ints, "+42,") == "42/3", "int plus sign");
+    check(outcome(ints, "-0") == "0/2", "int minus zero");
+    check(outcome(ints, "007") == "7/3", "int leading zeros");
+    check(outcome(ints, "0x1F") == "31/4", "int hex");
+    check(outcome(ints, "-0XfF") == "-255/5", "int negative hex");
+    check(outcome(ints, "0x7fffffff") == "2147483647/10", "int hex max");
+    check(outcome(ints, "0x80000000") == "error", "int hex overflow");
+    check(outcome(ints, "-x") == "fail", "int sign without digits");
+    check(outcome(ints, "+") == "fail", "int sign at end");
+    check(outcome(ints, "0x") == "fail", "int hex without digits");
+    check(outcome(ints, "-0xg") == "fail", "int signed hex without digits");
+    check(outcome(ints, "x") == "fail", "int without digits");
+
+    auto const shorts = accept_int<short>();
+    check(outcome(shorts, "32767") == "32767/5", "short max");
+    check(outcome(shorts, "-32768") == "-32768/6", "short min");
+    check(outcome(shorts, "32768") == "error", "short overflow");
+
+    auto const unsigneds = accept_int<unsigned>();
+    check(outcome(unsigneds, "4294967295") == "4294967295/10", "unsigned max");
+    check(outcome(unsigneds, "4294967296") == "error", "unsigned overflow");
+    check(outcome(unsigneds, "-1") == "fail", "unsigned has no sign");
+
+    auto const doubles = accept_float<double>();
+    check(outcome(doubles, "1.5") == "1.5/3", "double");
+    check(outcome(doubles, "-2.5e3") == "-2500/6", "double exponent");
+    check(outcome(doubles, ".5") == "0.5/2", "double fraction only");
+    check(outcome(doubles, "5.") == "5/2", "double trailing point");
+    check(outcome(doubles, "1e-3") == "0.001/4", "double negative exponent");
+    check(outcome(doubles, "+1E+2") == "100/5", "double signed exponent");
+    check(outcome(doubles, "1e400") == "error", "double overflow");
+    check(outcome(doubles, "1e400", false) == "error", "double overflow without a result");
+    check(outcome(doubles, "1e") == "fail", "double exponent without digits");
+    check(outcome(doubles, "1e+x") == "fail", "double signed exponent without digits");
+    check(outcome(doubles, "-") == "fail", "double sign without digits");
+    check(outcome(doubles, "-.e1") == "fail", "double point without digits");
+
+    string const long_digits = "123456789012345678901234567890.5e-3";
+    memory_range const r(long_digits);
+    memory_range::iterator i = r.first;
+    double v;
+    check(doubles(i, r, &v) && v == strtod(long_digits.c_str(), nullptr), "double beyond the fast path");
+
+    auto const floats = accept_float<float>();
+    check(outcome(floats, "3.25") == "3.25/4", "float");
+    check(outcome(floats, "1e39") == "error", "float overflow");
+}
+
+struct calc_add {
+    calc_add() {}
+    void operator() (int *res, int left, string&, int right) const {
+        *res = left + right;
+    }
+} const calc_add;
+
+struct calc_sub {
+    calc_sub() {}
+    void operator() (int *res, int left, string&, int right) const {
+        *res = left - right;
+    }
+} const calc_sub;
+
+struct calc_div {
+    calc_div() {}
+    void operator() (int *res, int left, string&, int right) const {
+        *res = left / right;
+    }
+} const calc_div;
+
+struct calc_pow {
+    calc_pow() {}
+    void operator() (int *res, int left, string&, int right) const {
+        *res = 1;
+        for (int n = 0; n < right; ++n) {
+            *res *= left;
+        }
+    }
+} const calc_pow;
+
+struct calc_neg {
+    calc_neg() {}
+    void operator() (int *res, string&, int right) const {
+        *res = -right;
+    }
+} const calc_neg;
+
+struct calc_fact {
+    calc_fact() {}
+    void operator() (int *res, int left, string&) const {
+        *res = 1;
+        for (int n = 2; n <= left; ++n) {
+            *res *= n;
+        }
+    }
+} const calc_fact;
+
+// Infix operators associate as declared, prefix and postfix operators bind
+// at their own precedence, and an operator token that matches nothing is not
+// an operator.
+void test_operators() {
+    auto const calc = operators(number_tok,
+        infix_left(10, tokenise(accept(is_char('+'))), calc_add),
+        infix_left(10, tokenise(accept(is_char('-'))), calc_sub),
+        infix_left(20, tokenise(accept(is_char('/'))), calc_div),
+        infix_right(30, tokenise(accept(is_char('^'))), calc_pow),
+        prefix(25, tokenise(accept(is_char('-'))), calc_neg),
+        postfix(40, tokenise(accept(is_char('!'))), calc_fact));
+    check(outcome(calc, "8-3-2") == "3/5", "infix left associates");
+    check(outcome(calc, "100/10/5") == "2/8", "infix left associates over division");
+    check(outcome(calc, "2^3^2") == "512/5", "infix right associates");
+    check(outcome(calc, "2^3+1") == "9/5", "tighter infix first");
+    check(outcome(calc, "1+2^2") == "5/5", "looser infix last");
+    check(outcome(calc, "--4") == "4/3", "prefix repeats");
+    check(outcome(calc, "-2^2") == "-4/4", "prefix binds looser than a tighter infix");
+    check(outcome(calc, "3!") == "6/2", "postfix");
+    check(outcome(calc, "3!!") == "720/3", "postfix repeats");
+    check(outcome(calc, "2*3") == "2/1", "unknown operator ends the expression");
+    check(outcome(calc, "-3!") == "-6/3", "postfix binds tighter than prefix");
+    check(outcome(calc, "2+3!") == "8/4", "postfix binds tighter than infix");
+    check(outcome(calc, "1+") == "error", "infix without an operand");
+    check(outcome(calc, "-") == "error", "prefix without an operand");
+    check(outcome(calc, "1+", false) == "error", "infix without an operand or a result");
+    string const dangling = "1+";
+    memory_range const r(dangling);
+    check(parse_message(calc, r).find("missing operand") != string::npos, "missing operand message");
+
+    auto const empty_infix = operators(number_tok,
+        infix_left(10, many(accept(is_char('~'))), calc_add));
+    check(outcome(empty_infix, "7") == "7/1", "empty infix token is not an operator");
+    check(outcome(empty_infix, "7~1") == "8/3", "nullable infix token that matches");
+    auto const empty_postfix = operators(number_tok,
+        postfix(10, many(accept(is_char('!'))), calc_fact));
+    check(outcome(empty_postfix, "3") == "3/1", "empty postfix token is not an operator");
+    check(outcome(empty_postfix, "3!") == "6/2", "nullable postfix token that matches");
+}
+
+struct pick_of_three {
+    pick_of_three() {}
+    void operator() (string *res, int j, string &a, string &b, string &c) const {
+        *res = to_string(j) + ":" + a + b + c;
+    }
+} const pick_of_three;
+
+// The alternative any() picks at the start of 'text', and what it matched.
+template <typename Parser>
+string pick(Parser const& p, string const& text) {
+    memory_range const r(text);
+    memory_range::iterator i = r.first;
+    string a;
+    try {
+        if (!p(i, r, &a, static_cast<default_inherited*>(nullptr))) {
+            return "fail";
+        }
+    } catch (parse_error const&) {
+        return "error";
+    }
+    return a + "/" + to_string(i - r.first);
+}
+
+// any() dispatches on the lookahead only among alternatives that cannot
+// match it; nullable alternatives and ones with unknown first sets, such as
+// handles and strict parsers, are tried in order, so the first alternative
+// that succeeds still wins.
+void test_choice() {
+    auto const digit = accept(is_digit);
+    auto const alpha = accept(is_alpha);
+    auto const bang = accept(is_char('!'));
+    check(pick(any(pick_of_three, digit, alpha, bang), "a") == "1:a/1", "dispatch on the lookahead");
+    check(pick(any(pick_of_three, digit, alpha, bang), "?") == "fail", "no alternative admits the lookahead");
+    check(pick(any(pick_of_three, digit, many(alpha), bang), "!") == "1:/0",
+        "nullable alternative matching nothing wins over a later one");
+    check(pick(any(pick_of_three, many(digit), alpha, bang), "a") == "0:/0",
+        "nullable first alternative wins");
+
+    using handle = parser_handle<memory_range::iterator, memory_range, string>;
+    handle const letter = alpha;
+    handle const number = digit;
+    check(pick(any(pick_of_three, letter, alpha, bang), "a") == "0:a/1", "handle before an overlapping alternative");
+    check(pick(any(pick_of_three, number, alpha, bang), "a") == "1:a/1", "failing handle falls through");
+    check(pick(any(pick_of_three, bang, letter, alpha), "a") == "1:a/1", "handle after a skipped alternative");
+
+    check(pick(any(pick_of_three, strict("digit expected", digit), alpha, bang), "a") == "error",
+        "strict alternative is tried first");
+    check(pick(any(pick_of_three, alpha, strict("digit expected", digit), bang), "a") == "0:a/1",
+        "strict alternative after a match is not tried");
+    check(pick(any(pick_of_three, alpha, strict("digit expected", digit), bang), "!") == "error",
+        "strict alternative before a matching one is tried");
+}
+
+// A push parser fed 1 byte chunks, chunks that split tokens, or the whole
+// input at once gives the result of parsing the buffer, and holds no more
+// than the stream buffer however the input is cut.
+void test_push() {
+#if !defined(USE_MMAP) && !defined(USE_MEMORY)
+    string text;
+    for (int n = 0; n < 6000; ++n) {
+        text += to_string(n * 7919) + "," + to_string(n) + ",-" + to_string(n * 31) + "\n";
+    }
+    istringstream in(text);
+    stream_range const r(in);
+    stream_range::iterator i = r.first;
+    vector<vector<int>> whole;
+    check(parse_csv(i, r, &whole) && static_cast<size_t>(i - r.first) == text.size(), "push reference parses");
+
+    for (size_t const step : {text.size(), size_t(1), size_t(3), size_t(7), size_t(1460)}) {
+        string const what = "push in chunks of " + to_string(step);
+        push_parser<decltype(parse_csv)> pp(parse_csv);
+        size_t most = 0;
+        for (size_t at = 0; at < text.size(); at += step) {
+            pp.feed(text.substr(at, step));
+            most = max(most, pp.retained());
+        }
+        check(pp.finish() && pp.result() == whole && static_cast<size_t>(pp.consumed()) == text.size(), what);
+        check(most <= r.buffer_size(), what + " retains at most the stream buffer");
+    }
+#endif
+}
+
+// Checks the table folded from 'p' against 'p' for every byte and EOF.
+template <typename Predicate>
+void check_table(Predicate const& p, string const& what) {
+    char_set const s(p);
+    for (int c = -1; c < 256; ++c) {
+        int const sym = (c < 0) ? EOF : c;
+        if (s(sym) != p(sym)) {
+            check(false, what + " table differs at " + to_string(sym));
+            return;
+        }
+    }
+}
+
+// Every predicate folds to a table that matches it, and a char is the byte
+// it holds, not EOF.
+void test_tables() {
+    check_table(is_any, "any");
+    check_table(is_alnum, "alnum");
+    check_table(is_alpha, "alpha");
+    check_table(is_blank, "blank");
+    check_table(is_cntrl, "cntrl");
+    check_table(is_digit, "digit");
+    check_table(is_graph, "graph");
+    check_table(is_lower, "lower");
+    check_table(is_print, "print");
+    check_table(is_punct, "punct");
+    check_table(is_space, "space");
+    check_table(is_upper, "upper");
+    check_table(is_xdigit, "xdigit");
+    check_table(is_eol, "eol");
+    check_table(is_eof, "eof");
+    check_table(is_char('a'), "char");
+    check_table(is_char('\x80'), "char 0x80");
+    check_table(is_char('\xff'), "char 0xff");
+    check_table(is_char(0xff), "int 0xff");
+    check_table(is_alpha || is_char('_') || is_eof, "either");
+    check_table(is_graph - is_punct, "except");
+
+    check(is_char('\xff')(0xff) && !is_char('\xff')(EOF), "char 0xff is a byte, not EOF");
+    string const text = "\xff\xff!";
+    memory_range const r(text);
+    memory_range::iterator i = r.first;
+    string a;
+    check(many(accept(is_char('\xff')))(i, r, &a) && a == "\xff\xff" && i - r.first == 2,
+        "many(char 0xff) stops at the first other byte");
+}
+
+// Bytes 0xff, counting the ones seen, so a test can tell that resyncing
+// found them.
+struct is_ff_counted {
+    using is_predicate_type = true_type;
+    static constexpr int rank = 0;
+    static int seen;
+    is_ff_counted() {}
+    bool operator() (int const c) const {
+        if (c == 0xff) {
+            ++seen;
+            return true;
+        }
+        return false;
+    }
+    string name() const {
+        return "0xff";
+    }
+} const is_ff_counted;
+
+int is_ff_counted::seen = 0;
+
+// par_many gives the result of many when guessed starts land inside items,
+// so chunks are parsed again sequentially, and resyncs on high bytes.
+void test_par_many() {
+    auto const record = all(parse_line, sep_by(all(parse_int, number_tok), separator_tok)
+        && discard(tokenise(accept(is_char(';')))));
+    string text;
+    for (int n = 0; n < 100; ++n) {
+        for (int k = 0; k < 1000; ++k) {
+            text += to_string(n * k % 997) + ((k < 999) ? ",\n" : ";\n");
+        }
+    }
+    memory_range const r(text);
+    memory_range::iterator i = r.first;
+    vector<vector<int>> sequential;
+    check(many(record)(i, r, &sequential) && i == r.last && sequential.size() == 100, "records parse");
+    memory_range::iterator j = r.first;
+    vector<vector<int>> parallel;
+    check(par_many(record, is_char('\n'), 4)(j, r, &parallel) && j == r.last && parallel == sequential,
+        "par_many with starts inside records matches many");
+
+    auto const marked = all(parse_line, sep_by(all(parse_int, number_tok), separator_tok)
+        && discard(accept(is_char('\xff'))));
+    string high;
+    for (int n = 0; n < 20000; ++n) {
+        high += to_string(n) + "," + to_string(n % 7) + "\xff";
+    }
+    memory_range const h(high);
+    memory_range::iterator k = h.first;
+    vector<vector<int>> marked_sequential;
+    check(many(marked)(k, h, &marked_sequential) && k == h.last, "marked records parse");
+    memory_range::iterator l = h.first;
+    vector<vector<int>> marked_parallel;
+    check(par_many(marked, is_ff_counted, 4)(l, h, &marked_parallel) && l == h.last
+        && marked_parallel == marked_sequential, "par_many resyncing on 0xff matches many");
+    check(is_ff_counted::seen > 0, "resync sees bytes 0xff");
+}
+
+// The first position in 'text' from 'from' whose symbol is not in 'p',
+// tested one byte at a time.
+template <typename Predicate>
+size_t scalar_scan(Predicate const& p, string const& text, size_t from) {
+    while (from < text.size() && p(static_cast<unsigned char>(text[from]))) {
+        ++from;
+    }
+    return from;
+}
+
+// Checks the vector scan of 'p' against the scalar one over 'text' from
+// every start, and many(accept(p)) over memory, which scans, against a
+// stream, which does not.
+template <typename Predicate>
+void check_scan(Predicate const& p, string const& text, string const& what) {
+    char_set const s(p);
+    for (size_t from = 0; from <= text.size(); ++from) {
+        char const* const f = text.data() + from;
+        char const* const l = text.data() + text.size();
+        if (static_cast<size_t>(s.scan(f, l) - text.data()) != scalar_scan(p, text, from)) {
+            check(false, what + " scan from " + to_string(from) + " of " + to_string(text.size()));
+            return;
+        }
+    }
+    auto const run = many(accept(p));
+    memory_range const m(text);
+    memory_range::iterator i = m.first;
+    string from_memory;
+    check(run(i, m, &from_memory) && static_cast<size_t>(i - m.first) == from_memory.size()
+        && from_memory.size() == scalar_scan(p, text, 0), what + " memory run");
+#if !defined(USE_MMAP) && !defined(USE_MEMORY)
+    istringstream in(text);
+    stream_range const r(in);
+    stream_range::iterator j = r.first;
+    string from_stream;
+    check(run(j, r, &from_stream) && from_stream == from_memory, what + " stream run matches memory");
+#endif
+}
+
+struct is_high {
+    using is_predicate_type = true_type;
+    static constexpr int rank = 0;
+    constexpr is_high() {}
+    constexpr bool operator() (int const c) const {
+        return c >= 0x80 && c <= 0xff;
+    }
+    string name() const {
+        return "high";
+    }
+} constexpr is_high;
+
+// The vector scans (32 byte blocks with AVX2, 16 with SSE4.1, built as
+// test_combinators, sse_combinators and scalar_combinators) agree with the
+// scalar scan for every length, every position of the first non-member
+// across the block boundaries, and random bytes including 0x80-0xff.
+void test_scan() {
+    auto const word = is_alpha || is_char(0x80) || is_char(0xc3) || is_char(0xff);
+    auto const high = is_high || is_char(0x7f);
+    string const members = "abzAZ\x80\xc3\xff";
+    mt19937 rng(2);
+    for (size_t n = 0; n < 200; ++n) {
+        string text;
+        for (size_t k = 0; k < n; ++k) {
+            text.push_back(members[rng() % members.size()]);
+        }
+        check_scan(word, text, "all members");
+        for (size_t k = 0; k < n; k += (k < 72) ? 1 : 7) {
+            string stop = text;
+            stop[k] = static_cast<char>((k & 1) ? 0xfe : '0');
+            check_scan(word, stop, "stop at " + to_string(k));
+        }
+        string noise;
+        for (size_t k = 0; k < n; ++k) {
+            noise.push_back(static_cast<char>(rng() & 0xff));
+        }
+        check_scan(word, noise, "random bytes");
+        check_scan(high, noise, "high bytes");
+        check_scan(is_graph, noise, "graphic");
+    }
+}
+
+// Parses 'in' with 'many(p)' after an alternative that runs it and fails.
+template <typename Parser>
+vector<int> replay(Parser const& p, memory_range const& in) {
+    vector<int> a;
+    memory_range::iterator i = in.first;
+    (attempt(many(p) && discard(accept(is_char('!')))) || many(p))(i, in, &a);
+    return a;
+}
+
+// A memoized parser feeding a vector under many appends on a miss and on a
+// hit, as the parser it wraps does.
+void test_memo() {
+    auto const ints = all(parse_int, number_tok);
+    auto const memo_ints = memo(ints);
+    string const text = "1 2 3 ";
+    memory_range const in(text);
+
+    vector<int> a;
+    memory_range::iterator i = in.first;
+    check(many(memo_ints)(i, in, &a) && a == vector<int> {1, 2, 3}, "many(memo(x)) appends misses");
+
+    auto const memo_replay = memo(ints);
+    vector<int> const plain = replay(ints, in);
+    vector<int> const hits = replay(memo_replay, in);
+    check(memo_replay.stats().hits >= 3, "many(memo(x)) replays hits");
+    check(hits == plain, "many(memo(x)) replays like the parser it wraps");
+}
+
+struct arena_words {
+    arena_words() {}
+    void operator() (arena_result<vector<string>> *ws, arena_string &w) const {
+        ws->push_back(move(w));
+    }
+} const arena_words;
+
+// Arena vectors take the arena of the scope open when they are made, and
+// reset keeps the largest chunk, not the newest.
+void test_arena() {
+    parse_arena arena(1 << 16);
+    arena_vector<int> outside;
+    {
+        arena_scope const scope(arena);
+        arena_vector<int> inside;
+        inside.push_back(1);
+        size_t const used = arena.used();
+        check(used > 0, "arena vector allocates from the scope");
+        outside.push_back(2);
+        check(arena.used() == used, "arena vector made outside a scope uses the heap");
+    }
+    arena.allocate(1 << 20);
+    arena.allocate(1 << 18);
+    arena.reset();
+    check(arena.reserved() > (1 << 20), "reset keeps the largest chunk");
+
+    // A grammar over arena results keeps its recogniser strings, vectors and
+    // all() temporaries in the arena of the result it parses into.
+    static_assert(is_same<arena_result<vector<vector<int>>>, arena_vector<arena_vector<int>>>::value,
+        "nested vectors rebind");
+    static_assert(is_same<arena_result<pair<string, int>>, pair<arena_string, int>>::value, "pairs rebind");
+    auto const words = many(all(arena_words, tokenise(some(accept<arena_string>(is_alpha)))));
+    string const text = "alpha beta gamma";
+    memory_range const r(text);
+    memory_range::iterator i = r.first;
+    arena_owned<decltype(words)::result_type> result;
+    size_t const before = result.arena().used();
+    {
+        arena_scope const scope(result.arena());
+        check(words(i, r, result.get()) && result->size() == 3 && (*result)[2] == "gamma",
+            "arena grammar parses");
+    }
+    check(result.arena().used() > before, "arena grammar allocates from the result's arena");
+    check(result->get_allocator() == arena_allocator<arena_string>(result.arena())
+        && (*result)[0].get_allocator() == arena_allocator<char>(result.arena()),
+        "arena results hold the result's arena");
+}
+
+// The events of the trace written after parsing 'text' with 'p', and the
+// number of rules and rings in it.
+template <typename Parser>
+uint64_t trace_of(Parser const& p, string const& text, uint32_t& names, uint32_t& rings) {
+    memory_range const r(text);
+    memory_range::iterator i = r.first;
+    p(i, r);
+    stringstream out;
+    parser_trace::write(out);
+    out.seekg(8);
+    out.read(reinterpret_cast<char*>(&names), sizeof(names));
+    for (uint32_t k = 0; k < names; ++k) {
+        uint32_t len;
+        out.read(reinterpret_cast<char*>(&len), sizeof(len));
+        out.seekg(len, ios_base::cur);
+    }
+    out.read(reinterpret_cast<char*>(&rings), sizeof(rings));
+    uint32_t thread;
+    uint64_t n = 0;
+    out.read(reinterpret_cast<char*>(&thread), sizeof(thread));
+    out.read(reinterpret_cast<char*>(&n), sizeof(n));
+    return out ? n : 0;
+}
+
+// Starting a trace again discards the events and rules of the earlier one.
+void test_trace() {
+    auto const words = many(define("word", tokenise(some(accept(is_alpha)))));
+    auto const numbers = many(define("number", tokenise(some(accept(is_digit)))));
+    uint32_t names, rings;
+    parser_trace::start();
+    uint64_t const first = trace_of(words, "ab cd", names, rings);
+    parser_trace::start();
+    uint64_t const second = trace_of(numbers, "12 34", names, rings);
+    parser_trace::stop();
+    check(first > 0 && second == first, "restarted trace holds only its own events");
+    check(names == 1 && rings == 1, "restarted trace holds only its own rules");
+}
+
 //----------------------------------------------------------------------------
 
 int main(int const argc, char const *argv[]) {
-    if (argc < 1) {
-        cerr << "no input files\n";
+    if (argc < 2) {
+        test_stream_range();
+        test_memo();
+        test_span();
+        test_except();
+        test_arena();
+        test_numbers();
+        test_operators();
+        test_choice();
+        test_push();
+        test_tables();
+        test_scan();
+        test_par_many();
+        test_trace();
+        cout << ((failures == 0) ? "all tests passed\n" : "tests failed\n");
+        return (failures == 0) ? 0 : 1;
     } else {
         for (int i = 1; i < argc; ++i) {
             profile<csv_parser>::reset();
             stream_range in(argv[i]);
             cout << argv[i] << "\n";
             int const chars_read = parse(in);
-            double const mb_per_s = static_cast<double>(chars_read) / static_cast<double>(profile<csv_parser>::report());
-            cout << "parsed: " << mb_per_s << "MB/s\n";
+            profile_report const report = profile<csv_parser>::report();
+            cout << "parsed: " << report.mb_per_s(chars_read) << "MB/s\n" << report << "\n";
+            cout << report.per_mb(chars_read) << "\n";
         }
     }
 }
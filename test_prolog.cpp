@@ -0,0 +1,390 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "prolog.hpp"
+
+using namespace std;
+
+struct base {};
+using lp = logic_parser<base>;
+
+//----------------------------------------------------------------------------
+// Regression tests for the Prolog parser and program.
+
+int failures = 0;
+
+void check(bool const ok, string const& what) {
+    if (!ok) {
+        cerr << "FAIL: " << what << "\n";
+        ++failures;
+    }
+}
+
+// Parses 'text' into 'prog', returning whether all of it was parsed.
+bool parse(string const& text, lp::program& prog) {
+    istringstream in(text);
+    stream_range const r(in);
+    return static_cast<size_t>(lp::parse(r, prog)) == text.size();
+}
+
+// The message 'f' throws, or an empty string if it does not throw.
+template <typename F> string thrown(F const& f) {
+    try {
+        f();
+    } catch (runtime_error const& e) {
+        return e.what();
+    }
+    return "";
+}
+
+// A run of cells with a size but no storage, so the heap checks can be
+// reached without allocating the heap.
+struct huge_run {
+    size_t n;
+
+    size_t size() const {
+        return n;
+    }
+
+    lp::cell const* begin() const {
+        return nullptr;
+    }
+
+    lp::cell const* end() const {
+        return nullptr;
+    }
+};
+
+// Names and arities have 29 bits in a cell, and heap indexes 32.
+void test_cells() {
+    size_t const limit = lp::cell::max_high;
+    check(lp::cell::functor(7, limit - 1).arity() == limit - 1, "largest arity fits");
+    check(lp::cell::variable(3, static_cast<lp::atom_t>(limit - 1)).atom() == limit - 1, "largest name fits");
+    check(lp::cell::functor(7, limit - 1).atom() == 7, "functor keeps its atom beside a large arity");
+    check(thrown([limit] {lp::cell::functor(0, limit);}) == "variable name or arity too large for a cell",
+        "arity past 29 bits throws");
+    check(thrown([limit] {lp::cell::variable(0, static_cast<lp::atom_t>(limit));})
+        == "variable name or arity too large for a cell", "variable name past 29 bits throws");
+
+    lp::program prog;
+    huge_run const run {size_t(1) << 32};
+    huge_run const none {0};
+    check(thrown([&prog, &run] {prog.new_compound(0, run);}) == "program heap is full",
+        "compound past 32 bit indexes throws");
+    check(thrown([&prog, &run, &none] {prog.new_clause(lp::cell::constant(0), run, none);})
+        == "program heap is full", "clause past 32 bit indexes throws");
+    check(prog.cell_count() == 0, "a full heap is left unchanged");
+}
+
+// Names the kind of node visited.
+struct kind_of : public lp::term_visitor {
+    string kind;
+
+    virtual void visit(lp::variable*) override {
+        kind = "variable";
+    }
+
+    virtual void visit(lp::compound*) override {
+        kind = "compound";
+    }
+
+    explicit kind_of(lp::term* t) {
+        t->accept(this);
+    }
+};
+
+// Nodes are views of the cells, and a variable has one node.
+void test_nodes() {
+    lp::program prog;
+    check(parse("p(X, f(X, a)) :- q(X), r.\n", prog), "clause parses");
+    lp::clause_node* const c = prog.node(prog.db.predicates()[0].clauses[0]);
+    check(string(prog.atoms.name(c->head->functor)) == "p" && c->head->args.size() == 2, "head node");
+    check(kind_of(c->head->args[0]).kind == "variable", "variable node");
+    lp::compound* const f = static_cast<lp::compound*>(c->head->args[1]);
+    check(kind_of(f).kind == "compound" && f->args.size() == 2, "compound node");
+    check(f->args[0] == c->head->args[0], "occurrences of a variable share a node");
+    check(kind_of(f->args[1]).kind == "compound"
+        && static_cast<lp::compound*>(f->args[1])->args.empty(), "atom node is a compound without arguments");
+    check(c->impl.size() == 2 && string(prog.atoms.name(c->impl[1]->functor)) == "r", "goal nodes");
+    check(c->reps.size() == 1 && c->reps[0] == c->head->args[0], "repeated variable nodes");
+    check(prog.node(prog.db.predicates()[0].clauses[0])->head == c->head, "term nodes are built once");
+}
+
+// The text of 'prog', as prolog prints it.
+string shown_program(lp::program const& prog) {
+    ostringstream out;
+    out << prog;
+    return out.str();
+}
+
+// Atoms are dense IDs in the order they are interned, arguments before the
+// functor of their term, one per name whatever its role, and interning a
+// name again gives the same ID.
+void test_atoms() {
+    lp::program prog;
+    check(parse("p(a, X) :- q(a, X, p).\nq(b).\n", prog), "atom program parses");
+    char const* const order[] = {"a", "X", "p", "q", "b"};
+    bool dense = prog.atoms.size() == 5;
+    for (lp::atom_t a = 0; dense && a < 5; ++a) {
+        dense = string(prog.atoms.name(a)) == order[a] && prog.atoms.intern(order[a]) == a;
+    }
+    check(dense && prog.atoms.size() == 5, "atoms are numbered in the order they are interned");
+
+    lp::clause const& c = prog.db.predicates()[0].clauses[0];
+    lp::heap_t const heap = prog.heap();
+    lp::cell const head_a = lp::args_of(heap, c.head)[0];
+    lp::cell const goal = heap[c.body];
+    check(head_a.raw() == lp::args_of(heap, goal)[0].raw(), "an atom has one cell value");
+    check(lp::args_of(heap, goal)[2].atom() == heap[c.head.index()].atom(),
+        "a name used as a functor and a constant is one atom");
+
+    lp::program many;
+    bool same = true;
+    for (int n = 0; n < 20000; ++n) {
+        same = same && many.atoms.intern("atom" + to_string(n)) == static_cast<lp::atom_t>(n);
+    }
+    for (int n = 0; n < 20000; n += 7) {
+        same = same && many.atoms.intern("atom" + to_string(n)) == static_cast<lp::atom_t>(n)
+            && string(many.atoms.name(n)) == "atom" + to_string(n);
+    }
+    check(same && many.atoms.size() == 20000, "interning again finds the same atom as the table grows");
+}
+
+// The clauses of 'shown' as Prolog text: the listing without its clause
+// numbers, repeated variables and goals.
+string clause_text(string const& shown) {
+    istringstream in(shown.substr(0, shown.find("\n\n")));
+    string text;
+    string line;
+    while (getline(in, line)) {
+        size_t const number = line.find_first_not_of(" 0123456789");
+        if (number != 0 && line.compare(number, 2, ". ") == 0) {
+            line.erase(0, number + 2);
+        }
+        size_t const reps = line.find(". [");
+        if (reps != string::npos) {
+            line.erase(reps + 1);
+        }
+        text += line + "\n";
+    }
+    return text;
+}
+
+// A program shows its predicates in the order they were first defined, the
+// clauses of each in order, and each goal's variables in order of first
+// occurrence; parsing the listing again shows the same program.
+void test_show() {
+    string const text = "r(Z) :- q(Z, W), s(W, Z).\np(X, f(X, a)) :- q(X, Y), r(Y).\nq(b, c).\n"
+        "r(a).\n:- p(B, A), r(A).\n:- q(A, A).\n";
+    lp::program prog;
+    check(parse(text, prog), "show program parses");
+    string const shown = shown_program(prog);
+    check(shown ==
+        "1. r(Z) :-\n"
+        "\tq(Z, W),\n"
+        "\ts(W, Z).\n"
+        "2. r(a).\n"
+        "3. p(X, f(X, a)) :-\n"
+        "\tq(X, Y),\n"
+        "\tr(Y). [X]\n"
+        "4. q(b, c).\n"
+        "\n"
+        "goal(B, A) :-\n"
+        "\tp(B, A),\n"
+        "\tr(A).\n"
+        "\n"
+        "goal(A) :-\n"
+        "\tq(A, A).\n"
+        "\n", "program listing");
+
+    lp::program again;
+    check(parse(text, again) && shown_program(again) == shown, "the same text shows the same listing");
+    lp::program listed;
+    check(parse(clause_text(shown), listed) && clause_text(shown_program(listed)) == clause_text(shown),
+        "a parsed listing shows the same clauses");
+}
+
+// The clauses of 'prog' that may match 'goal', found by testing every
+// clause: same functor and arity, and a first argument that is a variable
+// on either side or has the same principal functor.
+vector<lp::clause const*> brute_lookup(lp::program const& prog, lp::cell const goal) {
+    lp::heap_t const heap = prog.heap();
+    auto const functor = [heap] (lp::cell const t) {
+        return (t.tag() == lp::cell::str) ? heap[t.index()].raw()
+            : (t.tag() == lp::cell::con) ? lp::cell::functor(t.atom(), 0).raw() : 0;
+    };
+    vector<lp::clause const*> found;
+    for (auto const& p : prog.db.predicates()) {
+        for (auto const& c : p.clauses) {
+            if (functor(c.head) != functor(goal)) {
+                continue;
+            }
+            lp::cell_range const xs = lp::args_of(heap, c.head);
+            lp::cell_range const ys = lp::args_of(heap, goal);
+            if (xs.empty() || ys.empty() || functor(xs[0]) == 0 || functor(ys[0]) == 0
+                || functor(xs[0]) == functor(ys[0])) {
+                found.push_back(&c);
+            }
+        }
+    }
+    return found;
+}
+
+// Indexed lookups find the same clauses, in the same order, as testing
+// every clause, for goals bound and unbound on their first argument.
+void test_index() {
+    char const* const firsts[] = {"X", "_", "a", "b", "f(X)", "f(a, Y)", "g(b)", "f"};
+    char const* const heads[] = {"p(%)", "p(%, c)", "q(%)", "r"};
+    mt19937 rng(23);
+    string text;
+    for (int n = 0; n < 200; ++n) {
+        string head = heads[rng() % 4];
+        size_t const at = head.find('%');
+        if (at != string::npos) {
+            head.replace(at, 1, firsts[rng() % 8]);
+        }
+        text += head + ((n % 3 == 0) ? " :- r.\n" : ".\n");
+    }
+    text += ":- p(a), p(b), p(c), p(f(a)), p(f(b, c)), p(g(Z)), p(Z), p(f), p(a, c), p(f(b), c), p(W, c),"
+        " q(g(b)), q(h), q(_), r, s(a).\n";
+    lp::program prog;
+    check(parse(text, prog), "index program parses");
+    lp::clause const& directive = prog.goals[0];
+    bool same = true;
+    size_t matched = 0;
+    for (uint32_t g = 0; g < directive.goals; ++g) {
+        lp::cell const goal = prog.heap()[directive.body + g];
+        vector<lp::clause const*> indexed;
+        for (auto const& c : prog.db.lookup(prog.heap(), goal)) {
+            indexed.push_back(&c);
+        }
+        same = same && indexed == brute_lookup(prog, goal);
+        matched += indexed.size();
+    }
+    check(directive.goals == 16 && matched > 0, "index goals");
+    check(same, "indexed lookups match testing every clause");
+}
+
+string read_file(string const& name) {
+    ifstream in(name, ios_base::binary);
+    return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+}
+
+void write_file(string const& name, string const& text) {
+    ofstream out(name, ios_base::binary | ios_base::trunc);
+    out << text;
+}
+
+// Whether the image 'bytes' patched by 'patch' is rejected, leaving the
+// program it is loaded into empty.
+template <typename F>
+bool rejects(string const& source, string const& image, string bytes, F const& patch) {
+    lp::snapshot_header h;
+    memcpy(&h, bytes.data(), sizeof(h));
+    patch(h, bytes);
+    write_file(image, bytes);
+    lp::program prog;
+    bool const loaded = lp::load_snapshot(prog, source.c_str(), image.c_str());
+    return !loaded && prog.cell_count() == 0 && prog.atoms.size() == 0 && prog.db.size() == 0;
+}
+
+// The cell at 'at' in the heap of an image.
+lp::cell cell_at(lp::snapshot_header const& h, string const& bytes, uint64_t const at) {
+    lp::cell c;
+    memcpy(&c, bytes.data() + h.cells_offset + at * sizeof(c), sizeof(c));
+    return c;
+}
+
+void set_cell(lp::snapshot_header const& h, string& bytes, uint64_t const at, lp::cell const c) {
+    memcpy(&bytes[h.cells_offset + at * sizeof(c)], &c, sizeof(c));
+}
+
+// The first cell in the heap of an image with tag 't'.
+uint64_t first_tagged(lp::snapshot_header const& h, string const& bytes, lp::cell::tag_t const t) {
+    uint64_t at = 0;
+    while (cell_at(h, bytes, at).tag() != t) {
+        ++at;
+    }
+    return at;
+}
+
+// A snapshot loads as the program it was saved from, its records hold no
+// stale bytes, a complete but corrupt or orphaned image is rejected, and a
+// program loaded from one is read only.
+void test_snapshot() {
+    string const source = "test_prolog.tmp.pl";
+    string const image = source + ".snap";
+    write_file(source, "p(X, f(X, a)) :- q(X), r.\np(b, c).\n:- p(Y, Z).\n");
+    lp::program parsed;
+    check(parse(read_file(source), parsed), "snapshot source parses");
+    lp::save_snapshot(parsed, source.c_str(), image.c_str());
+    string const bytes = read_file(image);
+
+    lp::program loaded;
+    check(lp::load_snapshot(loaded, source.c_str(), image.c_str()), "snapshot loads");
+    check(shown_program(loaded) == shown_program(parsed) && loaded.cell_count() == parsed.cell_count(),
+        "snapshot loads as the program saved");
+    check(thrown([&loaded] {loaded.new_variable(0);}) == "program loaded from a snapshot is read only",
+        "loaded program is read only");
+
+    lp::snapshot_header h;
+    memcpy(&h, bytes.data(), sizeof(h));
+    size_t const used = offsetof(lp::clause, reps) + sizeof(uint32_t);
+    bool zeroed = true;
+    for (uint64_t c = 0; c < h.clauses + h.goals; ++c) {
+        uint64_t const at = ((c < h.clauses) ? h.clauses_offset + c * sizeof(lp::clause)
+            : h.goals_offset + (c - h.clauses) * sizeof(lp::clause));
+        for (size_t k = used; k < sizeof(lp::clause); ++k) {
+            zeroed = zeroed && bytes[at + k] == 0;
+        }
+    }
+    check(h.clauses == 2 && h.goals == 1 && zeroed, "clause record padding is zero");
+
+    lp::program orphan;
+    check(!lp::load_snapshot(orphan, "test_prolog.missing.pl", image.c_str()), "missing source is rejected");
+
+    check(rejects(source, image, bytes, [] (lp::snapshot_header const& h, string& b) {
+        set_cell(h, b, first_tagged(h, b, lp::cell::str), lp::cell::structure(0xfffffff0u));
+    }), "str index outside the heap is rejected");
+    check(rejects(source, image, bytes, [] (lp::snapshot_header const& h, string& b) {
+        set_cell(h, b, first_tagged(h, b, lp::cell::str), lp::cell::structure(
+            static_cast<uint32_t>(first_tagged(h, b, lp::cell::ref))));
+    }), "str pointing at a ref is rejected");
+    check(rejects(source, image, bytes, [] (lp::snapshot_header const& h, string& b) {
+        uint64_t const at = first_tagged(h, b, lp::cell::fun);
+        set_cell(h, b, at, lp::cell::functor(cell_at(h, b, at).atom(), lp::cell::max_high - 1));
+    }), "fun arity past the heap is rejected");
+    check(rejects(source, image, bytes, [] (lp::snapshot_header const& h, string& b) {
+        set_cell(h, b, first_tagged(h, b, lp::cell::con), lp::cell::constant(static_cast<lp::atom_t>(h.atoms)));
+    }), "atom past the atom table is rejected");
+    check(rejects(source, image, bytes, [] (lp::snapshot_header const& h, string& b) {
+        set_cell(h, b, first_tagged(h, b, lp::cell::ref), lp::cell::variable(static_cast<uint32_t>(h.cells), 0));
+    }), "ref outside the heap is rejected");
+    check(rejects(source, image, bytes, [] (lp::snapshot_header const& h, string& b) {
+        lp::cell const head = lp::cell::variable(static_cast<uint32_t>(first_tagged(h, b, lp::cell::ref)), 0);
+        memcpy(&b[h.clauses_offset + offsetof(lp::clause, head)], &head, sizeof(head));
+    }), "ref clause head is rejected");
+    check(!rejects(source, image, bytes, [] (lp::snapshot_header const&, string&) {}),
+        "unpatched copy of the image loads");
+
+    remove(image.c_str());
+    remove(source.c_str());
+}
+
+//----------------------------------------------------------------------------
+
+int main() {
+    test_cells();
+    test_nodes();
+    test_atoms();
+    test_show();
+    test_index();
+    test_snapshot();
+    cout << ((failures == 0) ? "all tests passed\n" : "tests failed\n");
+    return (failures == 0) ? 0 : 1;
+}
@@ -65,8 +65,8 @@ struct csv_parser : private parser {
         }
 
         int sum = 0;
-        for (int i = 0; i < a.size(); ++i) {
-            for (int j = 0; j < a[i].size(); ++j) {
+        for (size_t i = 0; i < a.size(); ++i) {
+            for (size_t j = 0; j < a[i].size(); ++j) {
                 sum += a[i][j];
             }
         }
@@ -92,8 +92,9 @@ int main(int const argc, char const *argv[]) {
                     csv_parser csv(in);
                     profile<csv_parser>::reset();
                     int const chars_read = csv();
-                    double const mb_per_s = static_cast<double>(chars_read) / static_cast<double>(profile<csv_parser>::report());
-                    cout << "parsed: " << mb_per_s << "MB/s" << endl;
+                    profile_report const report = profile<csv_parser>::report();
+                    cout << "parsed: " << report.mb_per_s(chars_read) << "MB/s" << endl << report << endl;
+                    cout << report.per_mb(chars_read) << endl;
                 }
             } catch (parse_error& e) {
                 cerr << argv[i] << ": " << e.what()
@@ -0,0 +1,139 @@
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <iomanip>
+
+#include "parser_combinators.hpp"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+// Converts a binary parser trace (see parser_trace) to Chrome trace JSON, for
+// chrome://tracing or Perfetto. Each rule call becomes a complete event from
+// its enter to its exit, fail or backtrack, on the thread that ran it. With
+// --offsets the input offset is used as the time axis, so the flame graph
+// shows which rules parsed which part of the input. Events carry the thread
+// number recorded with each ring as their tid. Calls whose enter was
+// overwritten in the ring are dropped, calls still open at the end of a
+// thread's trace are closed at its last event.
+
+string json_string(string const& s) {
+    string out = "\"";
+    for (char const c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+template <typename T> bool read(istream& in, T& t) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&t), sizeof(T)));
+}
+
+// indexed by trace_kind, calls still open at the end are reported as "open".
+char const* const results[] = {"open", "ok", "fail", "backtrack"};
+
+int main(int const argc, char const *argv[]) {
+    bool offsets = false;
+    char const* file = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--offsets") == 0) {
+            offsets = true;
+        } else {
+            file = argv[i];
+        }
+    }
+    if (file == nullptr) {
+        cerr << "usage: " << argv[0] << " [--offsets] trace\n";
+        return 1;
+    }
+
+    ifstream in(file, ios_base::in | ios_base::binary);
+    char magic[8];
+    if (!in.read(magic, sizeof(magic)) || memcmp(magic, "PCTRACE1", sizeof(magic)) != 0) {
+        cerr << file << ": not a parser trace\n";
+        return 1;
+    }
+
+    uint32_t names;
+    read(in, names);
+    vector<string> rules;
+    for (uint32_t k = 0; k < names; ++k) {
+        uint32_t len;
+        read(in, len);
+        string n(len, ' ');
+        in.read(&n[0], len);
+        rules.push_back(json_string(n));
+    }
+
+    uint32_t threads;
+    read(in, threads);
+    vector<uint32_t> tids;
+    vector<vector<trace_record>> traces;
+    uint64_t t0 = numeric_limits<uint64_t>::max();
+    for (uint32_t k = 0; k < threads; ++k) {
+        uint32_t thread;
+        uint64_t n;
+        read(in, thread);
+        read(in, n);
+        tids.push_back(thread);
+        traces.emplace_back(n);
+        in.read(reinterpret_cast<char*>(traces.back().data()), n * sizeof(trace_record));
+        if (n > 0) {
+            t0 = min(t0, traces.back().front().time_ns);
+        }
+    }
+    if (!in) {
+        cerr << file << ": truncated trace\n";
+        return 1;
+    }
+
+    cout << fixed << setprecision(3) << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (size_t k = 0; k < traces.size(); ++k) {
+        uint32_t const tid = tids[k];
+        vector<trace_record> const& trace = traces[k];
+        vector<trace_record> stack;
+        auto const emit = [&] (trace_record const& b, trace_record const& e) {
+            double ts, dur;
+            if (offsets) {
+                ts = static_cast<double>(b.offset);
+                dur = static_cast<double>(max<int64_t>(e.offset - b.offset, 0));
+            } else {
+                ts = static_cast<double>(b.time_ns - t0) / 1000.0;
+                dur = static_cast<double>(e.time_ns - b.time_ns) / 1000.0;
+            }
+            cout << (first ? "" : ",\n") << "{\"name\":" << rules[b.rule]
+                << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                << ",\"ts\":" << ts << ",\"dur\":" << dur
+                << ",\"args\":{\"from\":" << b.offset << ",\"to\":" << e.offset
+                << ",\"result\":\"" << results[e.kind] << "\"}}";
+            first = false;
+        };
+        for (trace_record const& e : trace) {
+            if (e.kind == trace_enter) {
+                stack.push_back(e);
+            } else if (!stack.empty()) {
+                emit(stack.back(), e);
+                stack.pop_back();
+            }
+        }
+        while (!stack.empty()) {
+            trace_record e = trace.back();
+            e.kind = trace_enter;
+            emit(stack.back(), e);
+            stack.pop_back();
+        }
+    }
+    cout << "\n],\"displayTimeUnit\":\"" << (offsets ? "ns" : "ms") << "\"}\n";
+}